@@ -0,0 +1,109 @@
+#include "alloccounter.h"
+
+#ifdef SDD_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <opencv2/core.hpp>
+
+namespace {
+
+thread_local std::uint64_t t_allocations = 0;
+thread_local std::uint64_t t_exempt      = 0;   // Allocations dans une portée AllocExempt
+thread_local int           t_exemptDepth = 0;
+thread_local int           t_inMatAllocator = 0;   // operator new appelé par l’allocateur Mat
+
+inline void countOne()
+{
+    if (t_exemptDepth > 0) ++t_exempt;
+    else                   ++t_allocations;
+}
+
+struct InMatAllocator {
+    InMatAllocator()  { ++t_inMatAllocator; }
+    ~InMatAllocator() { --t_inMatAllocator; }
+};
+
+//=== Allocateur cv::Mat : délègue à l’allocateur standard, compte les buffers ===
+// Un Mat = une allocation : le buffer (fastMalloc, invisible d’operator new) est compté
+// ici, l’UMatData que l’allocateur standard crée par operator new ne l’est pas en plus.
+class CountingMatAllocator : public cv::MatAllocator
+{
+public:
+    explicit CountingMatAllocator(cv::MatAllocator* inner) : m_inner(inner) {}
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                           cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override
+    {
+        if (!data) countOne();               // data fourni = Mat sur buffer externe
+        const InMatAllocator inner;
+        return m_inner->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(cv::UMatData* data, cv::AccessFlag flags,
+                  cv::UMatUsageFlags usageFlags) const override
+    {
+        const InMatAllocator inner;
+        return m_inner->allocate(data, flags, usageFlags);
+    }
+
+    void deallocate(cv::UMatData* data) const override
+    {
+        m_inner->deallocate(data);
+    }
+
+private:
+    cv::MatAllocator* m_inner;
+};
+
+void* countedMalloc(std::size_t size)
+{
+    if (t_inMatAllocator == 0) countOne();
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+//=== Remplacement global de operator new / delete ==============================
+void* operator new(std::size_t size)   { return countedMalloc(size); }
+void* operator new[](std::size_t size) { return countedMalloc(size); }
+void  operator delete(void* p) noexcept                   { std::free(p); }
+void  operator delete[](void* p) noexcept                 { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept      { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept    { std::free(p); }
+
+namespace alloccount {
+
+bool enabled() { return true; }
+
+void install()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        // Jamais détruit : des Mat peuvent survivre jusqu’à la fin du processus
+        cv::Mat::setDefaultAllocator(new CountingMatAllocator(cv::Mat::getStdAllocator()));
+    });
+}
+
+std::uint64_t threadCount()       { return t_allocations; }
+std::uint64_t threadExemptCount() { return t_exempt; }
+
+void enterExempt() { ++t_exemptDepth; }
+void leaveExempt() { --t_exemptDepth; }
+
+} // namespace alloccount
+
+#else
+
+namespace alloccount {
+
+bool          enabled()     { return false; }
+void          install()     {}
+std::uint64_t threadCount()       { return 0; }
+std::uint64_t threadExemptCount() { return 0; }
+
+} // namespace alloccount
+
+#endif // SDD_COUNT_ALLOCATIONS
@@ -0,0 +1,77 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <cstdint>
+
+/*
+ * Compteur d’allocations tas par thread :
+ * → operator new / delete globaux remplacés (allocations std::vector, Qt, …) ;
+ * → allocateur cv::Mat par défaut enveloppé : un Mat alloué compte pour une
+ *   allocation (buffer), son UMatData n’est pas recompté.
+ * Actif seulement si SDD_COUNT_ALLOCATIONS est défini (cf. sdd.pro) : sinon les
+ * compteurs restent à zéro et rien n’est remplacé.
+ *
+ * Usage : AllocScope scope; ...frame...; scope.count() doit valoir au plus
+ * kSteadyFrameBudget en régime établi (tests/test_allocations, --scale-report).
+ *
+ * Seuls les appels OpenCV dont le scratch interne ne peut pas être fourni par
+ * l’appelant passent dans des portées AllocExempt ; leurs sorties, elles, sont
+ * préallouées. Liste (PalmDetector::detect) :
+ *   resize INTER_AREA    tables d’offsets en AutoBuffer (> 1 Ko dès 256 colonnes) ;
+ *   CLAHE::apply         corps parallèles (makePtr) et tampon d’interpolation à chaque appel ;
+ *   erode / dilate       FilterEngine recréé à chaque appel (createMorphologyFilter
+ *                        n’est plus public depuis OpenCV 4) ;
+ *   findContours         copie bordée de l’image, stockage de chaînes, vecteurs de sortie ;
+ *   approxPolyDP         AutoBuffer de la taille du contour (tas au-delà de ~130 points) ;
+ *   fillConvexPoly       sommets recopiés en std::vector<Point2l> ;
+ *   distanceTransform    image temporaire bordée et table des carrés.
+ * Le dessin des annotations (PalmDetector::drawAnnotations) est hors de la frame mesurée.
+ */
+namespace alloccount {
+
+// Allocations hors portées AllocExempt tolérées par frame de détection en régime établi
+constexpr std::uint64_t kSteadyFrameBudget = 0;
+
+bool          enabled();      // true si compilé avec SDD_COUNT_ALLOCATIONS
+void          install();      // Installe l’allocateur cv::Mat compteur (idempotent)
+std::uint64_t threadCount();  // Allocations cumulées du thread appelant (hors AllocExempt)
+std::uint64_t threadExemptCount();  // Allocations faites dans des portées AllocExempt
+
+#ifdef SDD_COUNT_ALLOCATIONS
+void enterExempt();
+void leaveExempt();
+#else
+inline void enterExempt() {}
+inline void leaveExempt() {}
+#endif
+
+} // namespace alloccount
+
+/*
+ * Compte les allocations du thread courant depuis la construction.
+ */
+class AllocScope
+{
+public:
+    AllocScope() : m_start(alloccount::threadCount()) {}
+    std::uint64_t count() const { return alloccount::threadCount() - m_start; }
+
+private:
+    std::uint64_t m_start;
+};
+
+/*
+ * Portée d’un appel OpenCV qui alloue en interne (cf. liste ci-dessus) : ses
+ * allocations vont dans threadExemptCount() au lieu de threadCount().
+ */
+class AllocExempt
+{
+public:
+    AllocExempt()  { alloccount::enterExempt(); }
+    ~AllocExempt() { alloccount::leaveExempt(); }
+
+    AllocExempt(const AllocExempt&)            = delete;
+    AllocExempt& operator=(const AllocExempt&) = delete;
+};
+
+#endif // ALLOCCOUNTER_H
@@ -0,0 +1,43 @@
+#-------------------------------------------------
+# Micro-benchmark : étapes de détection de paume sur un corpus de frames
+# (indépendant du TARGET PalmDetectorGame, sans Qt)
+#-------------------------------------------------
+
+CONFIG   += c++17 console
+CONFIG   -= app_bundle qt
+
+TEMPLATE = app
+TARGET   = bench_detection
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../framesource.cpp \
+    ../../perfprobe.cpp \
+    ../../skinsegment.cpp \
+    ../../test_detectmultiscale.cpp \
+    ../../tracer.cpp
+
+HEADERS += \
+    ../../framesource.h \
+    ../../perfprobe.h \
+    ../../samplestats.h \
+    ../../skinsegment.h \
+    ../../test_detectmultiscale.h \
+    ../../tracer.h
+
+#----- OpenCV : même installation que sdd.pro sous Windows, pkg-config ailleurs -----
+win32 {
+    OPENCV_DIR = C:/opencv/opencv-4.10.0/build/install
+    INCLUDEPATH += $$OPENCV_DIR/include
+    LIBS += -L$$OPENCV_DIR/x64/mingw/lib \
+            -lopencv_core4100 \
+            -lopencv_imgproc4100 \
+            -lopencv_imgcodecs4100 \
+            -lopencv_videoio4100 \
+            -lopencv_objdetect4100
+} else {
+    CONFIG    += link_pkgconfig
+    PKGCONFIG += opencv4
+}
@@ -0,0 +1,249 @@
+// bench_detection : latence de chaque étape de détection de paume, isolée et de bout en bout.
+//  Corpus : répertoire de frames enregistrées (png/jpg…), ou une spec FrameSource
+//  (ex. synthetic:640x480, video:capture.mp4) dont on capture --frames images.
+//  Chaque frame est ramenée à chaque résolution demandée (INTER_AREA).
+// Sortie CSV sur stdout : resolution,stage,samples,mean_ms,p50_ms,p95_ms,p99_ms,fps
+//
+//   ./bench_detection frames/ --sizes 1280x720,640x480,320x240 --iterations 3
+//   ./bench_detection synthetic:640x480 --frames 200 --cascade ../../palm.xml
+
+#include "framesource.h"
+#include "samplestats.h"
+#include "skinsegment.h"
+#include "test_detectmultiscale.h"
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/objdetect.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+namespace {
+
+struct Args {
+    string       corpus;
+    vector<Size> sizes;                 // Vide : résolution d’origine uniquement
+    int          iterations = 3;        // Passes sur le corpus
+    int          frames     = 200;      // Frames capturées depuis une spec FrameSource
+    string       cascade    = PalmDetector::kDefaultCascadePath;
+};
+
+bool parseSize(const string& text, Size& out)
+{
+    int w = 0, h = 0;
+    if (sscanf(text.c_str(), "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0) return false;
+    out = Size(w, h);
+    return true;
+}
+
+bool parseArgs(int argc, char** argv, Args& args)
+{
+    for (int i = 1; i < argc; ++i) {
+        const string a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (a == "--sizes" && hasValue) {
+            stringstream list(argv[++i]);
+            string item;
+            while (getline(list, item, ',')) {
+                Size s;
+                if (!parseSize(item, s)) return false;
+                args.sizes.push_back(s);
+            }
+        } else if (a == "--iterations" && hasValue) {
+            args.iterations = max(1, atoi(argv[++i]));
+        } else if (a == "--frames" && hasValue) {
+            args.frames = max(1, atoi(argv[++i]));
+        } else if (a == "--cascade" && hasValue) {
+            args.cascade = argv[++i];
+        } else if (args.corpus.empty() && a.rfind("--", 0) != 0) {
+            args.corpus = a;
+        } else {
+            return false;
+        }
+    }
+    return !args.corpus.empty();
+}
+
+// Répertoire de frames, sinon spec FrameSource
+vector<Mat> loadCorpus(const Args& args)
+{
+    vector<Mat> frames;
+    vector<String> files;
+    try {
+        glob(args.corpus + "/*", files, false);
+    } catch (const cv::Exception&) {
+        files.clear();
+    }
+
+    if (!files.empty()) {
+        sort(files.begin(), files.end());
+        for (const String& f : files) {
+            Mat img = imread(f, IMREAD_COLOR);
+            if (!img.empty()) frames.push_back(img);
+        }
+        return frames;
+    }
+
+    unique_ptr<FrameSource> source = FrameSource::fromSpec(args.corpus);
+    if (auto* synthetic = dynamic_cast<SyntheticFrameSource*>(source.get()))
+        synthetic->setFps(0.0);   // Corpus capturé d’avance : pas de cadence caméra
+    for (int i = 0; i < args.frames; ++i) {
+        Mat f;
+        if (!source->grab(f) || f.empty()) break;
+        frames.push_back(f.clone());
+    }
+    return frames;
+}
+
+// Ne sert qu’à satisfaire le constructeur : le banc appelle detect() directement
+class NullFrameSource : public FrameSource {
+public:
+    bool grab(Mat&) override { return false; }
+    string name() const override { return "null"; }
+};
+
+void report(const string& resolution, const string& stage, const vector<double>& times)
+{
+    if (times.empty()) return;
+    const samplestats::Summary s = samplestats::summarize(times);
+    printf("%s,%s,%zu,%.4f,%.4f,%.4f,%.4f,%.1f\n", resolution.c_str(), stage.c_str(),
+           s.count, s.mean, s.p50, s.p95, s.p99, s.mean > 0 ? 1000.0 / s.mean : 0.0);
+}
+
+double timeMs(const function<void()>& fn)
+{
+    const auto t0 = chrono::steady_clock::now();
+    fn();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Args args;
+    if (!parseArgs(argc, argv, args)) {
+        cerr << "usage: bench_detection <frame-dir | source-spec> [--sizes WxH,...] "
+                "[--iterations N] [--frames N] [--cascade palm.xml]" << endl;
+        return 2;
+    }
+
+    vector<Mat> corpus;
+    try {
+        corpus = loadCorpus(args);
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    if (corpus.empty()) {
+        cerr << "bench_detection: no frame loaded from " << args.corpus << endl;
+        return 1;
+    }
+    if (args.sizes.empty())
+        args.sizes.push_back(corpus.front().size());
+
+    CascadeClassifier cascade;
+    const bool haveCascade = cascade.load(args.cascade);
+    if (!haveCascade)
+        cerr << "bench_detection: cascade not loaded (" << args.cascade
+             << "), cascade and end_to_end stages skipped" << endl;
+
+    // Mêmes paramètres que PalmDetector
+    const skin::Thresholds th;
+    Ptr<CLAHE> clahe = createCLAHE(2.0, Size(8, 8));
+    const Mat kernel = getStructuringElement(MORPH_ELLIPSE, Size(5, 5));
+
+    cerr << "corpus: " << corpus.size() << " frames, skin kernel "
+         << skin::isaName(skin::bestIsa()) << endl;
+    printf("resolution,stage,samples,mean_ms,p50_ms,p95_ms,p99_ms,fps\n");
+
+    for (const Size& size : args.sizes) {
+        const string resolution = to_string(size.width) + "x" + to_string(size.height);
+
+        vector<Mat> frames;
+        for (const Mat& f : corpus) {
+            Mat r;
+            if (f.size() == size) r = f;
+            else resize(f, r, size, 0, 0, INTER_AREA);
+            frames.push_back(r);
+        }
+
+        // Buffers préalloués : seules les étapes sont mesurées, pas les allocations
+        Mat ycrcb(size, CV_8UC3), cr(size, CV_8U), cb(size, CV_8U), mask(size, CV_8U),
+            scratch(size, CV_8U), dist(size, CV_32F);
+        vector<vector<Point>> contours;
+        vector<Rect> palms;
+        map<string, vector<double>> samples;
+        const vector<string> order = {
+            "cvtColor_ycrcb", "skin_crcb", "clahe", "inRange", "skin_fused",
+            "morphology", "contours", "distance_transform", "cascade", "end_to_end"
+        };
+
+        unique_ptr<PalmDetector> detector;
+        if (haveCascade) {
+            detector = make_unique<PalmDetector>(make_unique<NullFrameSource>(), args.cascade);
+            detector->setAsyncCascade(false);   // Coût cascade compris, reproductible
+        }
+
+        for (int it = 0; it < args.iterations; ++it) {
+            for (const Mat& frame : frames) {
+                // Conversion de couleur : OpenCV d’origine puis noyau fusionné
+                samples["cvtColor_ycrcb"].push_back(timeMs([&] { cvtColor(frame, ycrcb, COLOR_BGR2YCrCb); }));
+                samples["skin_crcb"].push_back(timeMs([&] {
+                    skin::bgrToCrCb(frame.data, frame.step, cr.data, cr.step, cb.data, cb.step,
+                                    frame.cols, frame.rows);
+                }));
+                samples["clahe"].push_back(timeMs([&] { clahe->apply(cr, cr); clahe->apply(cb, cb); }));
+                samples["inRange"].push_back(timeMs([&] {
+                    inRange(ycrcb, Scalar(0, th.crMin, th.cbMin), Scalar(255, th.crMax, th.cbMax), mask);
+                }));
+                samples["skin_fused"].push_back(timeMs([&] {
+                    skin::segmentBgr(frame.data, frame.step, mask.data, mask.step,
+                                     frame.cols, frame.rows, th);
+                }));
+
+                // Ouverture + fermeture telles que dans PalmDetector::segmentSkin
+                samples["morphology"].push_back(timeMs([&] {
+                    erode (mask, scratch, kernel);
+                    dilate(scratch, mask, kernel);
+                    dilate(mask, scratch, kernel);
+                    erode (scratch, mask, kernel);
+                }));
+
+                // findContours modifie son entrée en OpenCV < 3.2 : copie hors mesure
+                mask.copyTo(scratch);
+                samples["contours"].push_back(timeMs([&] {
+                    findContours(scratch, contours, RETR_EXTERNAL, CHAIN_APPROX_SIMPLE);
+                }));
+                samples["distance_transform"].push_back(timeMs([&] {
+                    distanceTransform(mask, dist, DIST_L2, 5);
+                }));
+
+                if (haveCascade) {
+                    const int minSide = 80;
+                    samples["cascade"].push_back(timeMs([&] {
+                        cascade.detectMultiScale(frame, palms, 1.1, 5, 0, Size(minSide, minSide));
+                    }));
+
+                    // Chaîne complète, suivi compris (detect ne dessine plus : drawAnnotations exclu)
+                    vector<Point> centers;
+                    samples["end_to_end"].push_back(timeMs([&] { detector->detect(frame, centers); }));
+                }
+            }
+        }
+
+        for (const string& stage : order)
+            report(resolution, stage, samples[stage]);
+    }
+    return 0;
+}
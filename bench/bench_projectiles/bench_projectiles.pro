@@ -0,0 +1,22 @@
+#-------------------------------------------------
+# Micro-benchmark : pas de simulation des projectiles
+# (résolution balistique à chaque pas vs vitesse précalculée)
+#-------------------------------------------------
+
+CONFIG   += c++17 console
+CONFIG   -= app_bundle qt
+
+TEMPLATE = app
+TARGET   = bench_projectiles
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../projectilesim.cpp
+
+HEADERS += \
+    ../../projectilesim.h
+
+# Mêmes options de vectorisation que sdd.pro
+*-g++*: QMAKE_CXXFLAGS += -fno-math-errno -fno-trapping-math -fvect-cost-model=dynamic
@@ -0,0 +1,129 @@
+// bench_projectiles : coût d’un pas de simulation pour N projectiles.
+//  → "solve" : ancienne boucle, résolution du tir (sqrt, cos, tan, V0) à chaque pas
+//  → "poly"  : ProjectileSim::step, vitesse résolue une fois au respawn
+// Sortie CSV sur stdout : count,steps,solve_ns_per_proj,poly_ns_per_proj,speedup,max_abs_diff
+//  max_abs_diff ≈ 1e-6 tant que personne n’arrive ; au-delà (~1000 pas), un arrondi peut
+//  figer un projectile un pas plus tôt d’un côté : écart d’un pas (≈ 0,02) au plus.
+
+#include "projectilesim.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// Copie de la boucle ProjectileSim::step d’avant le précalcul (référence "avant"),
+// mêmes tableaux lus/écrits hormis vx/vy/vz remplacés par la résolution du tir
+struct SolveState {
+    std::vector<float>        x0, y0, z0, tx, ty, tz, time, rot, prevRot;
+    std::vector<float>        px, py, pz, prevX, prevY, prevZ;
+    std::vector<std::uint8_t> flags;
+};
+
+void stepSolve(SolveState& s, float dt)
+{
+    const std::size_t n = s.time.size();
+    const float alpha = ProjectileSim::kLaunchAngleDeg * float(M_PI) / 180.f;
+    const float cosA  = std::cos(alpha);
+    const float sinA  = std::sin(alpha);
+    const float tanA  = std::tan(alpha);
+    const float g     = ProjectileSim::kGravity;
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC ivdep
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        const float live = float(int(s.flags[i]) & ProjectileSim::Active);
+
+        s.prevX[i] = s.px[i]; s.prevY[i] = s.py[i]; s.prevZ[i] = s.pz[i];
+        s.prevRot[i] = s.rot[i];
+
+        const float t = s.time[i] + dt * live;
+        s.time[i] = t;
+        s.rot[i] += ProjectileSim::kRotSpeed * dt * live;
+
+        const float dx = s.tx[i] - s.x0[i];
+        const float dy = s.ty[i] - s.y0[i];
+        const float dz = s.tz[i] - s.z0[i];
+        const float d  = std::sqrt(dx * dx + dz * dz);
+        const float invD = 1.f / (d > 1e-6f ? d : 1e-6f);
+        const float rise = d * tanA - dy;
+        const float h  = rise > 1e-6f ? rise : 1e-6f;
+        const float v0 = (d / cosA) * std::sqrt(g / (2.f * h));
+
+        const float vh = v0 * cosA * invD;
+        const float vy = v0 * sinA;
+        s.px[i] = s.x0[i] + dx * vh * t;
+        s.py[i] = s.y0[i] + vy * t - 0.5f * g * t * t;
+        s.pz[i] = s.z0[i] + dz * vh * t;
+    }
+
+    // Même passe de désactivation que ProjectileSim::step : un projectile arrivé
+    // à la cible y est figé dans les deux boucles, quel que soit le nombre de pas
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint8_t live    = s.flags[i] & ProjectileSim::Active;
+        const std::uint8_t reached = std::uint8_t(live & std::uint8_t(s.pz[i] >= ProjectileSim::kGoalZ));
+        const std::uint8_t done    = std::uint8_t((s.pz[i] >= s.tz[i]) | (s.py[i] < ProjectileSim::kKillY));
+        s.flags[i] = std::uint8_t((s.flags[i] | (reached << 3)) & ~done);
+    }
+}
+
+template <typename F>
+double timeNs(F&& f)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const int   steps = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    const float dt    = 1.f / 600.f;   // Vol ≈ 1,7 s : au-delà de ~1000 pas, les deux boucles figent les arrivés
+    const std::size_t counts[] = { 1000, 10000, 100000, 1000000 };
+
+    std::printf("count,steps,solve_ns_per_proj,poly_ns_per_proj,speedup,max_abs_diff\n");
+    for (std::size_t count : counts) {
+        ProjectileSim sim;
+        SolveState    ref;
+        sim.reserve(count);
+        std::srand(42);
+        for (std::size_t i = 0; i < count; ++i) {
+            const float rx = -5.f + 10.f * float(std::rand()) / RAND_MAX;
+            sim.add(int(i % 4), { rx, 0.f, -5.f }, { 0.f, 0.f, 12.f });
+            ref.x0.push_back(rx);  ref.y0.push_back(0.f); ref.z0.push_back(-5.f);
+            ref.tx.push_back(0.f); ref.ty.push_back(0.f); ref.tz.push_back(12.f);
+        }
+        for (auto* v : { &ref.time, &ref.rot, &ref.prevRot, &ref.px, &ref.py, &ref.pz,
+                         &ref.prevX, &ref.prevY, &ref.prevZ })
+            v->assign(count, 0.f);
+        ref.flags.assign(count, ProjectileSim::Active | ProjectileSim::Visible);
+
+        // Chauffe (caches, pages)
+        stepSolve(ref, 0.f);
+        sim.step(0.f);
+
+        const double solveNs = timeNs([&] { for (int k = 0; k < steps; ++k) stepSolve(ref, dt); });
+        const double polyNs  = timeNs([&] { for (int k = 0; k < steps; ++k) sim.step(dt); });
+
+        const ProjectileSim::Arrays& a = sim.data();
+        float maxDiff = 0.f;
+        for (std::size_t i = 0; i < count; ++i) {
+            maxDiff = std::max(maxDiff, std::fabs(a.px[i] - ref.px[i]));
+            maxDiff = std::max(maxDiff, std::fabs(a.py[i] - ref.py[i]));
+            maxDiff = std::max(maxDiff, std::fabs(a.pz[i] - ref.pz[i]));
+        }
+
+        const double perSolve = solveNs / (double(steps) * count);
+        const double perPoly  = polyNs  / (double(steps) * count);
+        std::printf("%zu,%d,%.3f,%.3f,%.2f,%g\n", count, steps, perSolve, perPoly,
+                    perPoly > 0 ? perSolve / perPoly : 0.0, maxDiff);
+    }
+    return 0;
+}
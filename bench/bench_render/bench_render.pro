@@ -0,0 +1,23 @@
+#-------------------------------------------------
+# Micro-benchmark : étage vertex du shader de scène
+# (matrice normale inversée par sommet vs calculée côté CPU)
+# À lancer sous llvmpipe : LIBGL_ALWAYS_SOFTWARE=1 QT_QPA_PLATFORM=offscreen
+#-------------------------------------------------
+
+QT       += core gui opengl
+
+CONFIG   += c++17 console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+TARGET   = bench_render
+
+INCLUDEPATH += ../..
+
+# Géométrie réelle des projectiles (Projectile::buildGeometry)
+SOURCES += \
+    main.cpp \
+    ../../projectile.cpp
+
+HEADERS += \
+    ../../projectile.h
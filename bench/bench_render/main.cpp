@@ -0,0 +1,295 @@
+// bench_render : coût de l’étage vertex pour N pommes (9.6k sommets chacune).
+//  → "gpu_inverse" : ancien shader, mat3(transpose(inverse(model))) à chaque sommet
+//  → "cpu_normal"  : matrice normale calculée côté CPU (QMatrix4x4::normalMatrix)
+// Chaque variante est mesurée en draw par objet (uniforms) et en draw instanciée.
+// Rendu hors écran dans un FBO minuscule pour que le coût fragment soit négligeable.
+// Sortie CSV sur stdout : variant,path,objects,vertices_per_frame,ms_per_frame,mverts_per_s
+//
+//   LIBGL_ALWAYS_SOFTWARE=1 QT_QPA_PLATFORM=offscreen ./bench_render 200 100 64
+
+#include "projectile.h"
+#include <QGuiApplication>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QSurfaceFormat>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+//=== Shaders ==================================================================
+const char* kVsUniformInverse = R"(#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+uniform mat4 uModel;
+uniform mat4 uViewProj;
+out vec3 vNormal;
+void main() {
+    vNormal     = mat3(transpose(inverse(uModel))) * aNormal;
+    gl_Position = uViewProj * uModel * vec4(aPos, 1.0);
+})";
+
+const char* kVsUniformCpu = R"(#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+uniform mat4 uModel;
+uniform mat3 uNormalMatrix;
+uniform mat4 uViewProj;
+out vec3 vNormal;
+void main() {
+    vNormal     = uNormalMatrix * aNormal;
+    gl_Position = uViewProj * uModel * vec4(aPos, 1.0);
+})";
+
+const char* kVsInstancedInverse = R"(#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 4) in mat4 iModel;
+uniform mat4 uViewProj;
+out vec3 vNormal;
+void main() {
+    vNormal     = mat3(transpose(inverse(iModel))) * aNormal;
+    gl_Position = uViewProj * iModel * vec4(aPos, 1.0);
+})";
+
+const char* kVsInstancedCpu = R"(#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 4) in mat4 iModel;
+layout(location = 8) in mat3 iNormal;
+uniform mat4 uViewProj;
+out vec3 vNormal;
+void main() {
+    vNormal     = iNormal * aNormal;
+    gl_Position = uViewProj * iModel * vec4(aPos, 1.0);
+})";
+
+const char* kFs = R"(#version 330 core
+in vec3 vNormal;
+out vec4 fragColor;
+void main() {
+    fragColor = vec4(abs(normalize(vNormal)), 1.0);
+})";
+
+// Même disposition que ProjectileInstance (meshregistry.h)
+struct Instance {
+    float model[16];
+    float normal[9];
+};
+
+struct Object {
+    QVector3D pos;
+    QVector3D axis;
+    float     angle;
+    float     size;
+};
+
+//=== Banc =====================================================================
+class Bench : protected QOpenGLFunctions_3_3_Core
+{
+public:
+    Bench(int objects, int frames) : m_frames(frames)
+    {
+        initializeOpenGLFunctions();
+
+        const std::vector<Projectile::Vertex> verts =
+            Projectile::buildGeometry(Projectile::Shape::Apple);
+        m_vertexCount = int(verts.size());
+
+        QRandomGenerator rng(42);
+        for (int i = 0; i < objects; ++i) {
+            Object o;
+            o.pos   = { float(rng.bounded(-5.0) + 2.5), float(rng.bounded(5.0)), float(-rng.bounded(10.0)) };
+            o.axis  = Projectile::kAxes[rng.bounded(4)];
+            o.angle = float(rng.bounded(360.0));
+            o.size  = 0.5f + float(rng.bounded(1.0));
+            m_objects.push_back(o);
+        }
+        m_instances.resize(m_objects.size());
+
+        m_vao.create();
+        m_vao.bind();
+
+        m_vbo.create();
+        m_vbo.bind();
+        m_vbo.allocate(verts.data(), int(verts.size() * sizeof(Projectile::Vertex)));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Projectile::Vertex),
+                              reinterpret_cast<void*>(offsetof(Projectile::Vertex, pos)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Projectile::Vertex),
+                              reinterpret_cast<void*>(offsetof(Projectile::Vertex, normal)));
+
+        m_instanceVbo.create();
+        m_instanceVbo.setUsagePattern(QOpenGLBuffer::StreamDraw);
+        m_instanceVbo.bind();
+        m_instanceVbo.allocate(int(m_instances.size() * sizeof(Instance)));
+        for (int c = 0; c < 4; ++c) {
+            glEnableVertexAttribArray(4 + c);
+            glVertexAttribPointer(4 + c, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                                  reinterpret_cast<void*>(offsetof(Instance, model) + c * 4 * sizeof(float)));
+            glVertexAttribDivisor(4 + c, 1);
+        }
+        for (int c = 0; c < 3; ++c) {
+            glEnableVertexAttribArray(8 + c);
+            glVertexAttribPointer(8 + c, 3, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                                  reinterpret_cast<void*>(offsetof(Instance, normal) + c * 3 * sizeof(float)));
+            glVertexAttribDivisor(8 + c, 1);
+        }
+        m_vao.release();
+
+        QMatrix4x4 proj, view;
+        proj.perspective(45.f, 1.f, 0.1f, 100.f);
+        view.lookAt({ 0.f, 2.f, 13.f }, { 0.f, 1.f, 0.f }, { 0.f, 1.f, 0.f });
+        m_viewProj = proj * view;
+    }
+
+    // Une ligne CSV par (variante, chemin)
+    void run()
+    {
+        std::printf("variant,path,objects,vertices_per_frame,ms_per_frame,mverts_per_s\n");
+        measure("gpu_inverse", "uniform",   kVsUniformInverse,   false, false);
+        measure("cpu_normal",  "uniform",   kVsUniformCpu,       false, true);
+        measure("gpu_inverse", "instanced", kVsInstancedInverse, true,  false);
+        measure("cpu_normal",  "instanced", kVsInstancedCpu,     true,  true);
+    }
+
+private:
+    QMatrix4x4 modelOf(const Object& o, int frame) const
+    {
+        QMatrix4x4 m;
+        m.translate(o.pos);
+        m.rotate(o.angle + 6.f * float(frame), o.axis);
+        m.scale(o.size);
+        return m;
+    }
+
+    // Travail CPU compris dans la mesure : matrices (et matrices normales) de chaque frame
+    void drawFrame(QOpenGLShaderProgram& prog, bool instanced, bool cpuNormal, int frame)
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        m_vao.bind();
+
+        if (instanced) {
+            for (std::size_t i = 0; i < m_objects.size(); ++i) {
+                const QMatrix4x4 model = modelOf(m_objects[i], frame);
+                std::copy(model.constData(), model.constData() + 16, m_instances[i].model);
+                if (cpuNormal) {
+                    const QMatrix3x3 n = model.normalMatrix();
+                    std::copy(n.constData(), n.constData() + 9, m_instances[i].normal);
+                }
+            }
+            m_instanceVbo.bind();
+            m_instanceVbo.write(0, m_instances.data(), int(m_instances.size() * sizeof(Instance)));
+            m_instanceVbo.release();
+            glDrawArraysInstanced(GL_TRIANGLES, 0, m_vertexCount, GLsizei(m_objects.size()));
+        } else {
+            for (const Object& o : m_objects) {
+                const QMatrix4x4 model = modelOf(o, frame);
+                prog.setUniformValue(m_locModel, model);
+                if (cpuNormal)
+                    prog.setUniformValue(m_locNormal, model.normalMatrix());
+                glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
+            }
+        }
+
+        m_vao.release();
+        glFinish();
+    }
+
+    void measure(const char* variant, const char* path, const char* vs, bool instanced, bool cpuNormal)
+    {
+        QOpenGLShaderProgram prog;
+        if (!prog.addShaderFromSourceCode(QOpenGLShader::Vertex, vs) ||
+            !prog.addShaderFromSourceCode(QOpenGLShader::Fragment, kFs) ||
+            !prog.link()) {
+            std::fprintf(stderr, "%s/%s: %s\n", variant, path, qPrintable(prog.log()));
+            return;
+        }
+        prog.bind();
+        prog.setUniformValue("uViewProj", m_viewProj);
+        m_locModel  = prog.uniformLocation("uModel");
+        m_locNormal = prog.uniformLocation("uNormalMatrix");
+
+        // Préchauffage : compilation paresseuse et allocations du driver hors mesure
+        for (int frame = 0; frame < 5; ++frame)
+            drawFrame(prog, instanced, cpuNormal, frame);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < m_frames; ++frame)
+            drawFrame(prog, instanced, cpuNormal, frame);
+        const auto t1 = std::chrono::steady_clock::now();
+        prog.release();
+
+        const double ms        = std::chrono::duration<double, std::milli>(t1 - t0).count() / m_frames;
+        const double vertices  = double(m_vertexCount) * double(m_objects.size());
+        std::printf("%s,%s,%zu,%.0f,%.3f,%.1f\n", variant, path, m_objects.size(),
+                    vertices, ms, vertices / (ms * 1e3));
+    }
+
+    int                      m_frames      = 0;
+    int                      m_vertexCount = 0;
+    int                      m_locModel    = -1;
+    int                      m_locNormal   = -1;
+    std::vector<Object>      m_objects;
+    std::vector<Instance>    m_instances;
+    QMatrix4x4               m_viewProj;
+    QOpenGLVertexArrayObject m_vao;
+    QOpenGLBuffer            m_vbo{QOpenGLBuffer::VertexBuffer};
+    QOpenGLBuffer            m_instanceVbo{QOpenGLBuffer::VertexBuffer};
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    QGuiApplication app(argc, argv);
+
+    const int objects = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    const int frames  = argc > 2 ? std::max(1, std::atoi(argv[2])) : 100;
+    const int size    = argc > 3 ? std::max(1, std::atoi(argv[3])) : 64;
+
+    QSurfaceFormat fmt;
+    fmt.setVersion(3, 3);
+    fmt.setProfile(QSurfaceFormat::CoreProfile);
+
+    QOpenGLContext ctx;
+    ctx.setFormat(fmt);
+    if (!ctx.create()) {
+        std::fprintf(stderr, "bench_render: impossible de créer un contexte OpenGL 3.3\n");
+        return 1;
+    }
+    QOffscreenSurface surface;
+    surface.setFormat(ctx.format());
+    surface.create();
+    if (!ctx.makeCurrent(&surface)) {
+        std::fprintf(stderr, "bench_render: makeCurrent a échoué\n");
+        return 1;
+    }
+
+    {
+        QOpenGLFramebufferObject fbo(size, size, QOpenGLFramebufferObject::Depth);
+        fbo.bind();
+        ctx.functions()->glViewport(0, 0, size, size);
+        ctx.functions()->glEnable(GL_DEPTH_TEST);
+
+        std::fprintf(stderr, "renderer: %s\n",
+                     reinterpret_cast<const char*>(ctx.functions()->glGetString(GL_RENDERER)));
+
+        Bench bench(objects, frames);
+        bench.run();
+        fbo.release();
+    }
+
+    ctx.doneCurrent();
+    return 0;
+}
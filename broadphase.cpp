@@ -0,0 +1,156 @@
+#include "broadphase.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using Vec3 = ProjectileSim::Vec3;
+
+Vec3  sub(const Vec3& a, const Vec3& b)         { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+Vec3  madd(const Vec3& a, const Vec3& d, float s) { return { a.x + d.x * s, a.y + d.y * s, a.z + d.z * s }; }
+float dot(const Vec3& a, const Vec3& b)         { return a.x * b.x + a.y * b.y + a.z * b.z; }
+float clamp01(float v)                          { return std::min(std::max(v, 0.f), 1.f); }
+
+} // namespace
+
+UniformGrid::UniformGrid(const Vec3& boundsMin, const Vec3& boundsMax, float cellSize)
+    : m_min(boundsMin)
+    , m_cellSize(cellSize)
+    , m_invCell(1.f / cellSize)
+    , m_nx(std::max(1, int(std::ceil((boundsMax.x - boundsMin.x) / cellSize))))
+    , m_ny(std::max(1, int(std::ceil((boundsMax.y - boundsMin.y) / cellSize))))
+    , m_nz(std::max(1, int(std::ceil((boundsMax.z - boundsMin.z) / cellSize))))
+{
+    m_cellStart.assign(cellCount() + 1, 0);
+    m_cursor.assign(cellCount(), 0);
+}
+
+int UniformGrid::cellCoord(float v, float origin, int n) const
+{
+    const int c = int(std::floor((v - origin) * m_invCell));
+    return std::min(std::max(c, 0), n - 1);
+}
+
+int UniformGrid::cellIndex(float x, float y, float z) const
+{
+    return (cellCoord(z, m_min.z, m_nz) * m_ny + cellCoord(y, m_min.y, m_ny)) * m_nx
+         + cellCoord(x, m_min.x, m_nx);
+}
+
+void UniformGrid::build(const ProjectileSim& sim, std::uint8_t mask)
+{
+    const ProjectileSim::Arrays& a = sim.data();
+    const int n = int(sim.size());
+
+    m_entryCell.resize(n);
+    std::fill(m_cellStart.begin(), m_cellStart.end(), 0);
+    m_indexed   = 0;
+    m_maxRadius = 0.f;
+
+    // 1) Cellule de chaque slot + histogramme (décalé d’une case)
+    for (int i = 0; i < n; ++i) {
+        if ((a.flags[i] & mask) != mask) {
+            m_entryCell[i] = -1;
+            continue;
+        }
+        const int c = cellIndex(a.px[i], a.py[i], a.pz[i]);
+        m_entryCell[i] = c;
+        ++m_cellStart[c + 1];
+        ++m_indexed;
+        const float dx = a.px[i] - a.prevX[i];
+        const float dy = a.py[i] - a.prevY[i];
+        const float dz = a.pz[i] - a.prevZ[i];
+        const float swept = 0.5f * a.size[i] + std::sqrt(dx * dx + dy * dy + dz * dz);
+        m_maxRadius = std::max(m_maxRadius, swept);
+    }
+
+    // 2) Somme préfixe → début de chaque cellule
+    for (int c = 0; c < cellCount(); ++c)
+        m_cellStart[c + 1] += m_cellStart[c];
+
+    // 3) Placement
+    m_sorted.resize(m_indexed);
+    std::copy(m_cellStart.begin(), m_cellStart.end() - 1, m_cursor.begin());
+    for (int i = 0; i < n; ++i) {
+        const int c = m_entryCell[i];
+        if (c >= 0)
+            m_sorted[m_cursor[c]++] = i;
+    }
+}
+
+int UniformGrid::querySegment(const Vec3& a, const Vec3& b, float radius,
+                              std::vector<int>& out) const
+{
+    // Boîte englobante de la capsule
+    return queryBox({ std::min(a.x, b.x) - radius, std::min(a.y, b.y) - radius, std::min(a.z, b.z) - radius },
+                    { std::max(a.x, b.x) + radius, std::max(a.y, b.y) + radius, std::max(a.z, b.z) + radius },
+                    out);
+}
+
+int UniformGrid::queryBox(const Vec3& lo, const Vec3& hi, std::vector<int>& out) const
+{
+    out.clear();
+    if (m_indexed == 0)
+        return 0;
+
+    const float r = m_maxRadius;
+    const int x0 = cellCoord(lo.x - r, m_min.x, m_nx);
+    const int x1 = cellCoord(hi.x + r, m_min.x, m_nx);
+    const int y0 = cellCoord(lo.y - r, m_min.y, m_ny);
+    const int y1 = cellCoord(hi.y + r, m_min.y, m_ny);
+    const int z0 = cellCoord(lo.z - r, m_min.z, m_nz);
+    const int z1 = cellCoord(hi.z + r, m_min.z, m_nz);
+
+    for (int z = z0; z <= z1; ++z)
+        for (int y = y0; y <= y1; ++y) {
+            const int row = (z * m_ny + y) * m_nx;
+            // Cellules x contiguës : une seule plage dans m_sorted
+            const int begin = m_cellStart[row + x0];
+            const int end   = m_cellStart[row + x1 + 1];
+            out.insert(out.end(), m_sorted.begin() + begin, m_sorted.begin() + end);
+        }
+    return int(out.size());
+}
+
+int UniformGrid::querySweptSegment(const Vec3& a0, const Vec3& b0, const Vec3& a1, const Vec3& b1,
+                                   float radius, std::vector<int>& out) const
+{
+    const Vec3 lo{ std::min({ a0.x, b0.x, a1.x, b1.x }) - radius,
+                   std::min({ a0.y, b0.y, a1.y, b1.y }) - radius,
+                   std::min({ a0.z, b0.z, a1.z, b1.z }) - radius };
+    const Vec3 hi{ std::max({ a0.x, b0.x, a1.x, b1.x }) + radius,
+                   std::max({ a0.y, b0.y, a1.y, b1.y }) + radius,
+                   std::max({ a0.z, b0.z, a1.z, b1.z }) + radius };
+    return queryBox(lo, hi, out);
+}
+
+float segmentSegmentDistance(const Vec3& p0, const Vec3& p1, const Vec3& q0, const Vec3& q1)
+{
+    // Points les plus proches p0 + s·d1 et q0 + t·d2, s et t bornés à [0, 1]
+    const Vec3  d1 = sub(p1, p0), d2 = sub(q1, q0), r = sub(p0, q0);
+    const float a = dot(d1, d1);
+    const float e = dot(d2, d2);
+    const float f = dot(d2, r);
+    constexpr float eps = 1e-8f;
+
+    float s = 0.f, t = 0.f;
+    if (a <= eps && e <= eps) {
+        return std::sqrt(dot(r, r));
+    } else if (a <= eps) {
+        t = clamp01(f / e);
+    } else {
+        const float c = dot(d1, r);
+        if (e <= eps) {
+            s = clamp01(-c / a);
+        } else {
+            const float b     = dot(d1, d2);
+            const float denom = a * e - b * b;
+            s = denom > eps ? clamp01((b * f - c * e) / denom) : 0.f;
+            t = (b * s + f) / e;
+            if (t < 0.f)      { t = 0.f; s = clamp01(-c / a); }
+            else if (t > 1.f) { t = 1.f; s = clamp01((b - c) / a); }
+        }
+    }
+    const Vec3 diff = sub(madd(p0, d1, s), madd(q0, d2, t));
+    return std::sqrt(dot(diff, diff));
+}
@@ -0,0 +1,68 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <cstdint>
+#include <vector>
+#include "projectilesim.h"
+
+/*
+ * Classe UniformGrid :
+ * → Broadphase des collisions : grille uniforme sur les bornes de la salle
+ *   (cf. GameScene::setupRoom), reconstruite à chaque pas par tri par comptage.
+ * → Chaque objet est rangé dans la cellule de son centre ; les requêtes élargissent
+ *   leur boîte du plus grand rayon indexé, un objet n’est donc rendu qu’une fois.
+ * → Le rayon indexé inclut le déplacement du dernier pas (|pos - prevPos|) : la sphère
+ *   couvre tout le volume balayé par l’objet pendant ce pas.
+ * → Les objets hors bornes tombent dans les cellules de bord.
+ * → Aucun conteneur n’est réalloué tant que le nombre d’objets ne grandit pas.
+ */
+class UniformGrid
+{
+public:
+    using Vec3 = ProjectileSim::Vec3;
+
+    UniformGrid(const Vec3& boundsMin, const Vec3& boundsMax, float cellSize);
+
+    // Indexe les slots de sim dont les drapeaux contiennent tous les bits de mask
+    void build(const ProjectileSim& sim, std::uint8_t mask = ProjectileSim::Active);
+
+    /**
+     * Volume balayé : capsule de a à b, de rayon radius.
+     * @param out Reçoit les indices candidats (vidé d’abord), à confirmer en narrowphase.
+     * @return Nombre de candidats.
+     */
+    int querySegment(const Vec3& a, const Vec3& b, float radius, std::vector<int>& out) const;
+
+    // Boîte [lo, hi] (élargie du plus grand rayon indexé), même contrat que querySegment
+    int queryBox(const Vec3& lo, const Vec3& hi, std::vector<int>& out) const;
+
+    // Segment qui se translate de [a0, b0] à [a1, b1] pendant le pas (lame du sabre) :
+    // boîte des deux positions élargie de radius sur les trois axes, même contrat
+    int querySweptSegment(const Vec3& a0, const Vec3& b0, const Vec3& a1, const Vec3& b1,
+                          float radius, std::vector<int>& out) const;
+
+    int   cellCount() const    { return m_nx * m_ny * m_nz; }
+    int   indexedCount() const { return m_indexed; }
+    float maxRadius() const    { return m_maxRadius; }
+
+private:
+    int  cellCoord(float v, float origin, int n) const;   // Coordonnée bornée à [0, n)
+    int  cellIndex(float x, float y, float z) const;
+
+    Vec3  m_min;
+    float m_cellSize, m_invCell;
+    int   m_nx, m_ny, m_nz;
+
+    std::vector<int> m_cellStart;   // Début de chaque cellule dans m_sorted (+1 sentinelle)
+    std::vector<int> m_cursor;      // Curseurs de remplissage (tri par comptage)
+    std::vector<int> m_entryCell;   // Cellule de chaque slot, -1 si non indexé
+    std::vector<int> m_sorted;      // Indices de slots triés par cellule
+    int              m_indexed   = 0;
+    float            m_maxRadius = 0.f;
+};
+
+// Narrowphase : distance minimale entre les segments [p0, p1] et [q0, q1]
+float segmentSegmentDistance(const ProjectileSim::Vec3& p0, const ProjectileSim::Vec3& p1,
+                             const ProjectileSim::Vec3& q0, const ProjectileSim::Vec3& q1);
+
+#endif // BROADPHASE_H
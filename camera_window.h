@@ -2,9 +2,53 @@
 #define CAMERAWINDOW_H
 
 #include <QWidget>
-#include <QLabel>
+#include <QImage>
+#include <QPainter>
 #include <QVBoxLayout>
 
+/*
+ * Classe PreviewView :
+ * → Peint directement une QImage possédée par l’appelant, sans passer par un
+ *   QPixmap (QPixmap::fromImage allouait et convertissait à chaque frame).
+ * → Image centrée dans la zone utile, bordure verte de kBorder px autour.
+ */
+class PreviewView : public QWidget {
+    Q_OBJECT
+public:
+    static constexpr int kBorder = 2;
+
+    explicit PreviewView(QWidget* parent = nullptr) : QWidget(parent) {}
+
+    // Image à afficher (nullptr = rien) ; doit rester valide jusqu’au prochain appel
+    void setImage(const QImage* image)
+    {
+        m_image = image;
+        update();
+    }
+
+    // Zone disponible pour l’image, bordure exclue
+    QSize imageArea() const { return rect().adjusted(kBorder, kBorder, -kBorder, -kBorder).size(); }
+
+protected:
+    void paintEvent(QPaintEvent*) override
+    {
+        QPainter painter(this);
+        if (m_image && !m_image->isNull()) {
+            const QRect area = rect().adjusted(kBorder, kBorder, -kBorder, -kBorder);
+            QRect target(QPoint(0, 0), m_image->size());
+            target.moveCenter(area.center());
+            painter.drawImage(target.topLeft(), *m_image);
+        }
+        painter.setPen(QPen(Qt::green, kBorder));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(QRectF(rect()).adjusted(kBorder / 2.0, kBorder / 2.0,
+                                                 -kBorder / 2.0, -kBorder / 2.0));
+    }
+
+private:
+    const QImage* m_image = nullptr;
+};
+
 /*
  * Classe CameraWindow :
  * → Widget Qt embarqué pour afficher le flux vidéo de la caméra.
@@ -14,28 +58,26 @@ class CameraWindow : public QWidget {
 public:
     explicit CameraWindow(QWidget* parent = nullptr)
         : QWidget(parent)
-        , m_label(new QLabel(this))
+        , m_view(new PreviewView(this))
     {
         // Pas de titre de fenêtre quand intégré dans un layout
         // setWindowTitle("Camera Feed");
 
-        // Taille fixe pour le placeholder du flux (320×240 px)
-        m_label->setFixedSize(320, 240);
-        // Bordure verte pour délimiter la zone de la vidéo
-        m_label->setStyleSheet("border:2px solid green;");
+        // Taille fixe pour le placeholder du flux (320×240 px, bordure verte comprise)
+        m_view->setFixedSize(320, 240);
 
         // Layout vertical sans marges pour un embedding serré
         auto* layout = new QVBoxLayout(this);
         layout->setContentsMargins(0, 0, 0, 0);
-        layout->addWidget(m_label);
+        layout->addWidget(m_view);
         setLayout(layout);
     }
 
-    // Expose le QLabel pour que MainWindow puisse y afficher la frame caméra
-    QLabel* label() const { return m_label; }
+    // Expose la vue pour que MainWindow puisse y afficher la frame caméra
+    PreviewView* view() const { return m_view; }
 
 private:
-    QLabel* m_label;  // Affiche le feed vidéo
+    PreviewView* m_view;  // Affiche le feed vidéo
 };
 
 #endif // CAMERAWINDOW_H
@@ -0,0 +1,37 @@
+#include "fragmentpool.h"
+#include <algorithm>
+
+FragmentPool::FragmentPool(int capacity)
+{
+    // Capacité paire : une coupe occupe toujours deux slots consécutifs
+    m_sim.resize(std::size_t(std::max(2, capacity + (capacity & 1))));
+}
+
+void FragmentPool::spawnPair(const Vec3& pos, const Vec3& vel, int shape, float size, float rot, int axis)
+{
+    // Écartement de la coupe : ±0.1 en x, ±1 m/s latéral, +2 m/s vers le haut
+    for (int side = 0; side < 2; ++side) {
+        const float sign = side == 0 ? 1.f : -1.f;
+
+        ProjectileSim::Launch l;
+        l.shape    = shape;
+        l.start    = { pos.x + 0.1f * sign, pos.y, pos.z };
+        l.velocity = { vel.x + 1.f * sign, vel.y + 2.f, vel.z };
+        l.size     = size;
+        l.rot      = rot;
+        l.axis     = axis;
+        l.flags    = ProjectileSim::Active | ProjectileSim::Visible
+                   | (side == 1 ? ProjectileSim::Mirrored : 0);
+
+        m_sim.launch(m_next, l);
+        m_next = (m_next + 1) % capacity();
+    }
+}
+
+void FragmentPool::clear()
+{
+    for (int i = 0; i < capacity(); ++i) {
+        m_sim.setActive(i, false);
+        m_sim.setVisible(i, false);
+    }
+}
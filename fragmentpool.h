@@ -0,0 +1,38 @@
+#ifndef FRAGMENTPOOL_H
+#define FRAGMENTPOOL_H
+
+#include "projectilesim.h"
+
+/*
+ * Classe FragmentPool :
+ * → Moitiés de fruits produites par une coupe, simulées dans un ProjectileSim
+ *   de capacité fixe allouée une fois (aucune allocation pendant la partie).
+ * → Les slots sont recyclés en anneau : une coupe réutilise les deux plus anciens,
+ *   actifs ou non (les fragments ont tous à peu près la même durée de vie).
+ * → Chaque fragment dessine le demi-mesh de sa forme (MeshRegistry::halfMesh),
+ *   le fragment gauche avec le drapeau Mirrored.
+ */
+class FragmentPool
+{
+public:
+    using Vec3 = ProjectileSim::Vec3;
+
+    static constexpr int kDefaultCapacity = 256;
+
+    explicit FragmentPool(int capacity = kDefaultCapacity);
+
+    // Coupe d’un projectile : deux moitiés écartées de part et d’autre du plan de coupe
+    void spawnPair(const Vec3& pos, const Vec3& vel, int shape, float size, float rot, int axis);
+    void step(float dt) { m_sim.step(dt); }
+    void clear();                                // Désactive tous les fragments
+
+    ProjectileSim&       sim()       { return m_sim; }
+    const ProjectileSim& sim() const { return m_sim; }
+    int capacity() const { return int(m_sim.size()); }
+
+private:
+    ProjectileSim m_sim;
+    int           m_next = 0;    // Prochain slot recyclé
+};
+
+#endif // FRAGMENTPOOL_H
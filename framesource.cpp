@@ -0,0 +1,162 @@
+#include "framesource.h"
+#include <opencv2/imgproc.hpp>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+
+using namespace cv;
+using namespace std;
+
+//=== Fabrique ===================================================================
+
+unique_ptr<FrameSource> FrameSource::fromSpec(const string& spec)
+{
+    const size_t colon = spec.find(':');
+    const string kind  = spec.substr(0, colon);
+    const string arg   = (colon == string::npos) ? string() : spec.substr(colon + 1);
+
+    if (kind == "camera") {
+        int deviceId = 0;
+        try {
+            deviceId = arg.empty() ? 0 : stoi(arg);
+        } catch (const exception&) {
+            throw runtime_error("Error: Invalid camera index in frame source: " + spec);
+        }
+        return make_unique<CameraFrameSource>(deviceId);
+    }
+    if (kind == "video") {
+        if (arg.empty())
+            throw runtime_error("Error: Missing path in frame source: " + spec);
+        return make_unique<VideoFileFrameSource>(arg);
+    }
+    if (kind == "synthetic") {
+        SyntheticFrameSource::Settings cfg;
+        if (!arg.empty()) {
+            int w = 0, h = 0;
+            double fps = cfg.fps;
+            const int n = sscanf(arg.c_str(), "%dx%d@%lf", &w, &h, &fps);
+            if (n < 2 || w <= 0 || h <= 0)
+                throw runtime_error("Error: Invalid synthetic frame source: " + spec);
+            cfg.size = Size(w, h);
+            if (n == 3) cfg.fps = fps;
+        }
+        return make_unique<SyntheticFrameSource>(cfg);
+    }
+    throw runtime_error("Error: Unknown frame source: " + spec);
+}
+
+//=== Caméra =====================================================================
+
+CameraFrameSource::CameraFrameSource(int deviceId)
+    : m_deviceId(deviceId)
+{
+    cap.open(deviceId);
+    if (!cap.isOpened()) {
+        throw runtime_error("Error: Unable to open camera device");
+    }
+}
+
+bool CameraFrameSource::grab(Mat& frame)
+{
+    cap >> frame;
+    return !frame.empty();
+}
+
+string CameraFrameSource::name() const
+{
+    return "camera:" + to_string(m_deviceId);
+}
+
+//=== Vidéo / séquence d’images ==================================================
+
+VideoFileFrameSource::VideoFileFrameSource(const string& path, bool loop)
+    : m_path(path)
+    , m_loop(loop)
+{
+    cap.open(path);
+    if (!cap.isOpened()) {
+        throw runtime_error("Error: Unable to open video source: " + path);
+    }
+}
+
+bool VideoFileFrameSource::grab(Mat& frame)
+{
+    cap >> frame;
+    if (frame.empty() && m_loop) {
+        // Fin de fichier : on rembobine (réouverture pour les séquences d’images)
+        cap.open(m_path);
+        cap >> frame;
+    }
+    return !frame.empty();
+}
+
+string VideoFileFrameSource::name() const
+{
+    return "video:" + m_path;
+}
+
+//=== Synthétique ================================================================
+
+SyntheticFrameSource::SyntheticFrameSource(const Settings& cfg)
+    : m_cfg(cfg)
+    , m_next(chrono::steady_clock::now())
+{
+    if (m_cfg.path.empty()) {
+        // Boucle par défaut : balayage horizontal, diagonales, retour au centre
+        m_cfg.path = { {0.5f, 0.5f}, {0.2f, 0.5f}, {0.8f, 0.5f}, {0.2f, 0.25f},
+                       {0.8f, 0.75f}, {0.5f, 0.3f}, {0.5f, 0.7f} };
+    }
+    m_cfg.framesPerSegment = max(1, m_cfg.framesPerSegment);
+}
+
+Point2f SyntheticFrameSource::centerAt(uint64_t frameIndex) const
+{
+    const size_t   n   = m_cfg.path.size();
+    const uint64_t seg = frameIndex / m_cfg.framesPerSegment;
+    const float    t   = float(frameIndex % m_cfg.framesPerSegment) / m_cfg.framesPerSegment;
+    const Point2f& a   = m_cfg.path[seg % n];
+    const Point2f& b   = m_cfg.path[(seg + 1) % n];
+    const Point2f  p   = a + (b - a) * t;
+    return { p.x * m_cfg.size.width, p.y * m_cfg.size.height };
+}
+
+bool SyntheticFrameSource::grab(Mat& frame)
+{
+    if (m_cfg.fps > 0.0) {
+        this_thread::sleep_until(m_next);
+        m_next += chrono::microseconds(static_cast<long long>(1e6 / m_cfg.fps));
+    }
+
+    frame.create(m_cfg.size, CV_8UC3);
+    frame.setTo(Scalar(90, 60, 40));
+
+    // Bruit déterministe (graine = index de frame) pour ne pas segmenter un fond parfait
+    RNG rng(0x5DDu + m_index);
+    m_noise.create(frame.size(), CV_8UC3);
+    rng.fill(m_noise, RNG::UNIFORM, Scalar::all(0), Scalar::all(12));
+    frame += m_noise;
+
+    const Point2f c = centerAt(m_index);
+    const RotatedRect palm(c, Size2f(m_cfg.palmSize), 0.f);
+    Point2f corners[4];
+    palm.points(corners);
+    Point pts[4];
+    for (int i = 0; i < 4; ++i) pts[i] = corners[i];
+    fillConvexPoly(frame, pts, 4, Scalar(140, 170, 220), LINE_AA);
+
+    ++m_index;
+    return true;
+}
+
+void SyntheticFrameSource::setFps(double fps)
+{
+    m_cfg.fps = fps;
+    m_next    = chrono::steady_clock::now();
+}
+
+string SyntheticFrameSource::name() const
+{
+    return "synthetic:" + to_string(m_cfg.size.width) + "x" + to_string(m_cfg.size.height)
+         + "@" + to_string(m_cfg.fps);
+}
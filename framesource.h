@@ -0,0 +1,102 @@
+#ifndef FRAMESOURCE_H
+#define FRAMESOURCE_H
+
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Classe FrameSource :
+ * → Interface d’une source de frames BGR pour PalmDetector.
+ * → Implémentations : caméra live, vidéo / séquence d’images, générateur synthétique.
+ */
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    /**
+     * Lit la frame suivante (peut bloquer jusqu’à sa disponibilité).
+     * @param frame frame BGR en sortie (buffer réutilisé si possible)
+     * @return false si aucune frame n’est disponible
+     */
+    virtual bool grab(cv::Mat& frame) = 0;
+
+    virtual std::string name() const = 0;  // Description lisible (logs, benchs)
+
+    /**
+     * Construit une source à partir d’une spec texte :
+     *   "camera:<id>"                      caméra OpenCV (ex. camera:1)
+     *   "video:<chemin>"                   fichier vidéo ou séquence (ex. video:frames/%04d.png), en boucle
+     *   "synthetic[:<w>x<h>[@<fps>]]"      blob couleur peau sur trajectoire scriptée
+     *                                      (30 fps par défaut comme une webcam, @0 = sans cadence)
+     * @throws runtime_error si la spec est invalide ou la source impossible à ouvrir
+     */
+    static std::unique_ptr<FrameSource> fromSpec(const std::string& spec);
+};
+
+/*
+ * Caméra live (cv::VideoCapture sur un index de périphérique).
+ */
+class CameraFrameSource : public FrameSource {
+public:
+    explicit CameraFrameSource(int deviceId);  // throws runtime_error si échec d’ouverture
+    bool grab(cv::Mat& frame) override;
+    std::string name() const override;
+
+private:
+    cv::VideoCapture cap;
+    int              m_deviceId;
+};
+
+/*
+ * Vidéo enregistrée ou séquence d’images (motif printf), relue en boucle.
+ */
+class VideoFileFrameSource : public FrameSource {
+public:
+    explicit VideoFileFrameSource(const std::string& path, bool loop = true);
+    bool grab(cv::Mat& frame) override;
+    std::string name() const override;
+
+private:
+    cv::VideoCapture cap;
+    std::string      m_path;
+    bool             m_loop;
+};
+
+/*
+ * Générateur synthétique déterministe :
+ * → fond bruité + paume (quadrilatère couleur peau) suivant une trajectoire scriptée.
+ * → La position ne dépend que de l’index de frame : reproductible d’une machine à l’autre.
+ */
+class SyntheticFrameSource : public FrameSource {
+public:
+    struct Settings {
+        cv::Size size            = {640, 480};
+        double   fps             = 30.0;          // Cadence type webcam ; 0 = aussi vite que possible
+        cv::Size palmSize        = {120, 140};    // Taille de la paume (px)
+        int      framesPerSegment = 30;           // Durée d’un segment de trajectoire
+        std::vector<cv::Point2f> path;            // Waypoints normalisés [0,1], vide = boucle par défaut
+    };
+
+    explicit SyntheticFrameSource(const Settings& cfg);
+    bool grab(cv::Mat& frame) override;
+    std::string name() const override;
+
+    cv::Point2f centerAt(std::uint64_t frameIndex) const;  // Centre attendu (px) pour la frame donnée
+    std::uint64_t frameIndex() const { return m_index; }
+
+    // Change la cadence (0 = sans cadence, pour les captures préalables des rapports / bancs)
+    void setFps(double fps);
+
+private:
+    Settings                              m_cfg;
+    std::uint64_t                         m_index = 0;
+    std::chrono::steady_clock::time_point m_next;
+    cv::Mat                               m_noise;   // Bruit réutilisé d’une frame à l’autre
+};
+
+#endif // FRAMESOURCE_H
@@ -1,5 +1,9 @@
 #include "GameScene.h"
 #include "Projectile.h"
+#include "meshregistry.h"
+#include "texturecache.h"
+#include "glstats.h"
+#include "perfprobe.h"
 #include <QOpenGLShaderProgram>
 #include <QOpenGLShader>
 #include <QtMath>
@@ -8,6 +12,9 @@
 #include <QOpenGLPaintDevice>
 #include <QPainter>
 #include <QFont>
+#include <QDebug>
+#include <utility>
+#include <algorithm>
 
 
 static const char* vShaderSrc = R"(#version 330 core
@@ -15,21 +22,63 @@ layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aUV;
 layout(location = 3) in vec3 aColor;
+layout(location = 11) in float aUntextured;   // 1 : face coupée, couleur de sommet
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProj;
+uniform mat3 uNormalMatrix;   // transpose(inverse(mat3(uModel))), calculée côté CPU
+// Doit correspondre à SceneBlock (sceneuniforms.h)
+layout(std140) uniform SceneBlock {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uLightDir;
+    vec4 uViewPos;
+};
 
 out vec3 vNormal;
 out vec3 vWorldPos;
 out vec2 vUV;
 out vec3 vColor;
+out float vUntextured;
 
 void main() {
-    vNormal    = mat3(transpose(inverse(uModel))) * aNormal;
+    vNormal    = uNormalMatrix * aNormal;
     vWorldPos  = vec3(uModel * vec4(aPos, 1.0));
     vUV        = aUV;
     vColor     = aColor;
+    vUntextured = aUntextured;
+    gl_Position = uProj * uView * vec4(vWorldPos, 1.0);
+})";
+
+// Variante instanciée : la matrice modèle vient du buffer d’instances
+static const char* vInstancedShaderSrc = R"(#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aUV;
+layout(location = 3) in vec3 aColor;
+layout(location = 11) in float aUntextured;   // 1 : face coupée, couleur de sommet
+layout(location = 4) in mat4 iModel;
+layout(location = 8) in mat3 iNormal;   // Matrice normale par instance (CPU)
+
+// Doit correspondre à SceneBlock (sceneuniforms.h)
+layout(std140) uniform SceneBlock {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uLightDir;
+    vec4 uViewPos;
+};
+
+out vec3 vNormal;
+out vec3 vWorldPos;
+out vec2 vUV;
+out vec3 vColor;
+out float vUntextured;
+
+void main() {
+    vNormal    = iNormal * aNormal;
+    vWorldPos  = vec3(iModel * vec4(aPos, 1.0));
+    vUV        = aUV;
+    vColor     = aColor;
+    vUntextured = aUntextured;
     gl_Position = uProj * uView * vec4(vWorldPos, 1.0);
 })";
 
@@ -38,9 +87,16 @@ in vec3 vNormal;
 in vec3 vWorldPos;
 in vec2 vUV;
 in vec3 vColor;
+in float vUntextured;
+
+// Doit correspondre à SceneBlock (sceneuniforms.h)
+layout(std140) uniform SceneBlock {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uLightDir;
+    vec4 uViewPos;
+};
 
-uniform vec3   uLightDir;
-uniform vec3   uViewPos;
 uniform int    uHasTex;
 uniform sampler2D uTexture;
 uniform float  uShininess;
@@ -52,14 +108,14 @@ out vec4 fragColor;
 
 void main()
 {
-    // When textured, we ignore vColor; otherwise take the vertex color
-    vec3 base = (uHasTex == 1)
+    // When textured, we ignore vColor (except on untextured vertices: cut faces)
+    vec3 base = (uHasTex == 1 && vUntextured < 0.5)
               ? texture(uTexture, vUV).rgb
               : vColor;
 
     vec3 N = normalize(vNormal);
-    vec3 L = normalize(uLightDir);
-    vec3 V = normalize(uViewPos - vWorldPos);
+    vec3 L = normalize(uLightDir.xyz);
+    vec3 V = normalize(uViewPos.xyz - vWorldPos);
     vec3 H = normalize(L + V);
 
     float diff = max(dot(N, L), 0.15);                    // diffuse + ambient
@@ -90,6 +146,7 @@ GameScene::GameScene(QWidget* parent)
         m_gameTimer.restart();
         emit elapsedTimeChanged(0.0f);
         m_startButton->hide();
+        restartClock();
         m_frameTimer->start(16);
         update();
     });
@@ -102,26 +159,31 @@ GameScene::GameScene(QWidget* parent)
     emit elapsedTimeChanged(0.0f);
 
     connect(m_restartButton, &QPushButton::clicked, this, [this]() {
-        m_score = 0;
-        emit scoreChanged(0);
-        m_gameOver = false;
-        m_gameStarted = true;
-        m_gameTimer.restart();
-        emit elapsedTimeChanged(0.0f);
-        m_restartButton->hide();
-
-        for (auto* p : m_projectiles) {
-            float rx = randomX(-5.f, 5.f);
-            p->setShape(Projectile::RandomShape());
-            p->reset({rx, 0.f, -5.f}, {0.f, 0.f, 12.f});
-            p->setVisible(true);
-            p->setActive(true);
-        }
-
+        restartGame();
         update();
     });
 
 }
+
+void GameScene::restartGame()
+{
+    m_score = 0;
+    emit scoreChanged(0);
+    m_gameOver = false;
+    m_gameStarted = true;
+    m_gameTimer.restart();
+    emit elapsedTimeChanged(0.0f);
+    m_restartButton->hide();
+    restartClock();
+    m_fragments.clear();
+    m_particles.clear();
+    m_simTime = 0.0;
+
+    for (int i = 0; i < int(m_sim.size()); ++i) {
+        float rx = randomX(-5.f, 5.f);
+        m_sim.respawn(i, int(Projectile::RandomShape()), {rx, 0.f, -5.f}, {0.f, 0.f, 12.f});
+    }
+}
 void GameScene::resizeEvent(QResizeEvent* evt) {
     QOpenGLWidget::resizeEvent(evt);
     if (m_startButton) {
@@ -187,23 +249,16 @@ void GameScene::drawCylinderGrid()
 {
     glLineWidth(3.0f);
 
-    m_shader->bind();
-    m_cylinderVao.bind();
-
-    QMatrix4x4 model;
-    model.setToIdentity();
-
-    m_shader->setUniformValue("uModel", model);
-    m_shader->setUniformValue("uView",  m_view);
-    m_shader->setUniformValue("uProj",  m_proj);
-    m_shader->setUniformValue("uHasTex",        0);
-    m_shader->setUniformValue("uEmissionColor", QVector3D(1.0f, 1.0f, 1.0f));
-    m_shader->setUniformValue("uEmissionPower", 0.0f);
+    const QMatrix4x4 model;
+    const QMatrix3x3 normal;
+    glBindVertexArray(m_cylinderVao.objectId());
+    glUniformMatrix4fv(m_sceneLoc.model, 1, GL_FALSE, model.constData());
+    glUniformMatrix3fv(m_sceneLoc.normalMatrix, 1, GL_FALSE, normal.constData());
+    glUniform1i(m_sceneLoc.hasTex, 0);
 
     glDrawArrays(GL_LINES, 0, m_cylinderVertexCount);
 
-    m_cylinderVao.release();
-    m_shader->release();
+    glBindVertexArray(0);
 }
 
 
@@ -299,65 +354,68 @@ void GameScene::setupRoom()
     } else {
         m_frontTexture.reset(new QOpenGLTexture(frontImg.mirrored()));
     }
-
-
-    m_groundTexture.reset(new QOpenGLTexture(groundImg.mirrored()));
-    m_wallTexture.reset(new QOpenGLTexture(sideWallImg.mirrored()));
-    m_ceillingTexture.reset(new QOpenGLTexture(ceilingImg.mirrored()));
-    m_frontTexture.reset(new QOpenGLTexture(frontImg.mirrored()));
-
 }
-void GameScene::drawExplosionParticles(const Explosion& ex) {
-
-    static QVector<QVector3D> offsets;
-    if (offsets.isEmpty()) {
-        constexpr int   PARTICLE_COUNT = 500;
-        constexpr float SPREAD         = 0.8f;
-
-        offsets.reserve(PARTICLE_COUNT);
-        for (int i = 0; i < PARTICLE_COUNT; ++i) {
-            float rx = (QRandomGenerator::global()->bounded(-100,100) / 100.0f) * SPREAD;
-            float ry = (QRandomGenerator::global()->bounded(-100,100) / 100.0f) * SPREAD;
-            float rz = (QRandomGenerator::global()->bounded(-100,100) / 100.0f) * SPREAD;
-            offsets.append({ rx, ry, rz });
+void GameScene::updateSwordPosition(const QVector3D& pos, const LatencyStamp& stamp)
+{
+    const perf::ScopedTimer timer(perf::SwordUpdate);
+    if (m_sword) {
+        recordSwordSample(pos, m_gameTimer.elapsed());
+
+        // Une position remplacée avant d’être dessinée n’est jamais vue : seule la dernière compte
+        if (m_latencyProbe && stamp.grabNs != 0) {
+            m_pendingLatency         = stamp;
+            m_pendingLatency.swordNs = latencyNow();
         }
+        update();
     }
+}
 
-    QVector<QVector3D> points;
-    points.reserve(offsets.size());
-    for (auto &o : offsets)
-        points.append(ex.position + o);
-
-    m_particleVbo.bind();
-    m_particleVbo.allocate(points.constData(), points.size() * sizeof(QVector3D));
-
-    m_shader->bind();
-    m_shader->setUniformValue("uHasTex",         0);
-    m_shader->setUniformValue("uEmissionColor",  QVector3D(1.0f, 0.8f, 0.0f));
-    m_shader->setUniformValue("uEmissionPower",  1.5f);
-
-    m_shader->enableAttributeArray(0);
-    m_shader->setAttributeBuffer(0, GL_FLOAT, 0, 3, sizeof(QVector3D));
-
-    glEnable(GL_PROGRAM_POINT_SIZE);
-    glPointSize(8.0f);
-    glDrawArrays(GL_POINTS, 0, points.size());
-    glDisable(GL_PROGRAM_POINT_SIZE);
+void GameScene::recordSwordSample(const QVector3D& pos, qint64 ms)
+{
+    m_sword->setPosition(pos);
 
-    m_shader->disableAttributeArray(0);
-    m_shader->release();
-    m_particleVbo.release();
+    // Horodatage pour que la simulation retrouve la trajectoire entre deux frames caméra
+    m_swordHistory[m_swordHistoryHead] = { ms, pos };
+    m_swordHistoryHead  = (m_swordHistoryHead + 1) % kSwordHistory;
+    m_swordHistoryCount = qMin(m_swordHistoryCount + 1, kSwordHistory);
 }
-void GameScene::updateSwordPosition(const QVector3D& pos)
+
+QVector3D GameScene::swordPositionAt(qint64 ms) const
 {
-    if (m_sword) {
-        m_sword->setPosition(pos);
-        update();
+    if (m_swordHistoryCount == 0)
+        return m_sword->position();
+
+    // Du plus récent au plus ancien : premier échantillon antérieur à ms
+    auto sample = [this](int age) -> const SwordSample& {
+        return m_swordHistory[(m_swordHistoryHead - 1 - age + kSwordHistory) % kSwordHistory];
+    };
+    if (ms >= sample(0).ms)
+        return sample(0).pos;
+    for (int age = 1; age < m_swordHistoryCount; ++age) {
+        const SwordSample& older = sample(age);
+        if (ms >= older.ms) {
+            const SwordSample& newer = sample(age - 1);
+            const qint64 span = newer.ms - older.ms;
+            const float  f    = span > 0 ? float(ms - older.ms) / float(span) : 1.f;
+            return older.pos + (newer.pos - older.pos) * f;
+        }
     }
+    return sample(m_swordHistoryCount - 1).pos;
+}
+
+void GameScene::restartClock()
+{
+    if (m_sword) m_prevSwordPos = m_sword->position();
+    m_swordHistoryCount = 0;
+    m_lastTickMs        = m_gameTimer.elapsed();
+    m_elapsed.restart();
+    m_accumulator = 0.0;
+    m_renderAlpha = 1.f;
 }
 
 void GameScene::tick()
 {
+    const perf::ScopedTimer timer(perf::Tick);
     if (m_gameStarted && !m_gameOver) {
         float t = m_gameTimer.elapsed() * 1e-3f;
         emit elapsedTimeChanged(t);
@@ -366,71 +424,135 @@ void GameScene::tick()
     if (!m_gameStarted || m_gameOver)
         return;
 
-    m_explosions.clear();
+    const double seconds = m_elapsed.nsecsElapsed() * 1e-9;
+    m_elapsed.restart();
+    advance(seconds, m_gameTimer.elapsed());
+    update();
+}
 
-    float dt = m_elapsed.restart() * 1e-3f;
-    QVector3D swordPos = m_sword->position();
+void GameScene::advance(double seconds, qint64 nowMs)
+{
+    // Temps écoulé, borné : si le rendu décroche, on ralentit plutôt que
+    // d’enchaîner un nombre illimité de pas (coût de simulation prévisible)
+    m_accumulator = qMin(m_accumulator + seconds, kMaxStepsPerTick * m_simStep);
+
+    // Les pas de ce tick se répartissent l’intervalle réel [m_lastTickMs, now] :
+    // chacun reçoit la position du sabre à son instant, tirée de l’historique caméra
+    const int    steps  = int(m_accumulator / m_simStep);
+    const qint64 fromMs = m_lastTickMs;
+    m_lastTickMs = nowMs;
+
+    for (int k = 1; k <= steps && !m_gameOver; ++k) {
+        const qint64 stepMs = fromMs + (nowMs - fromMs) * k / steps;
+        m_simTime += m_simStep;
+        simulateStep(float(m_simStep), swordPositionAt(stepMs));
+        m_accumulator -= m_simStep;
+    }
 
-    for (auto* p : m_projectiles) {
-        if (!p->isActive())
-            continue;
+    // Le rendu interpole entre les deux derniers états simulés
+    m_renderAlpha = float(m_accumulator / m_simStep);
+}
 
-        p->advanceTime(dt);
-        float z = p->position().z();
+// Conversion vers le type des helpers de collision (broadphase.h, sans Qt)
+static ProjectileSim::Vec3 toSim(const QVector3D& v)
+{
+    return { v.x(), v.y(), v.z() };
+}
 
-        if (z >= 11.f) {
+void GameScene::simulateStep(float dt, const QVector3D& swordPos)
+{
+    const ProjectileSim::Arrays& a = m_sim.data();
+
+    // Trajectoires de tous les projectiles (et fragments) en une passe
+    m_sim.step(dt);
+    m_fragments.step(dt);
+
+    for (int i = 0; i < int(m_sim.size()); ++i) {
+        // Avant le test Active : à bas sim-hz le pas qui franchit la ligne désactive aussi
+        if (m_sim.hasReached(i)) {
             m_gameOver = true;
             m_restartButton->show();
             return;
         }
+        if (!m_sim.isActive(i))
+            continue;
+
+        const float z = a.pz[i];
+        if (m_hideInTunnel && z >= 7.5f && z <= 12.f)
+            m_sim.setVisible(i, false);
+    }
 
-        float dist = (p->position() - swordPos).length();
-        if (dist < p->size() - 0.2f) {
+    // Collision continue : la lame est un segment qui se translate de prevSwordPos
+    // à swordPos pendant le pas. Dans le repère du sabre la lame est fixe et le
+    // projectile parcourt [p0 - prevSwordPos, p1 - swordPos] : on compare la
+    // distance segment-segment au rayon du fruit + demi-largeur de lame.
+    const QVector3D prevSwordPos = m_prevSwordPos;
+    m_prevSwordPos = swordPos;
+
+    const QVector3D bladeBase(0.f, Sword::kBladeBase, 0.f);
+    const QVector3D bladeTip (0.f, Sword::kBladeTip,  0.f);
+    const ProjectileSim::Vec3 base = toSim(bladeBase), tip = toSim(bladeTip);
+    // Broadphase : les deux positions de la lame, élargies de sa demi-largeur sur les
+    // trois axes (le seuil narrowphase l’inclut aussi au-delà de la base et de la pointe)
+    const ProjectileSim::Vec3 base0 = toSim(prevSwordPos + bladeBase), tip0 = toSim(prevSwordPos + bladeTip);
+    const ProjectileSim::Vec3 base1 = toSim(swordPos + bladeBase),     tip1 = toSim(swordPos + bladeTip);
+
+    m_grid.build(m_sim);
+    m_grid.querySweptSegment(base0, tip0, base1, tip1, Sword::kBladeHalfWidth, m_candidates);
+
+    for (int i : m_candidates) {
+        const QVector3D prevPos(a.prevX[i], a.prevY[i], a.prevZ[i]);
+        const QVector3D pos(a.px[i], a.py[i], a.pz[i]);
+        const float dist = segmentSegmentDistance(toSim(prevPos - prevSwordPos), toSim(pos - swordPos),
+                                                  base, tip);
+        if (dist < 0.5f * a.size[i] + Sword::kBladeHalfWidth) {
             ++m_score;
             emit scoreChanged(m_score);
 
-            p->setActive(false);
-            p->setVisible(false);
+            m_sim.setActive(i, false);
+            m_sim.setVisible(i, false);
+            m_fragments.spawnPair(m_sim.position(i), m_sim.velocity(i), a.shape[i],
+                                  a.size[i], a.rot[i], a.axis[i]);
 
-            Explosion ex;
-            ex.position = p->position();
-            m_explosions.append(ex);
+            m_particles.spawn(pos, float(m_simTime));
 
             if (m_sfxPlayer) {
                 m_sfxPlayer->stop();
                 m_sfxPlayer->play();
             }
         }
+    }
 
-        else if (m_hideInTunnel && z >= 7.5f && z <= 12.f) {
-            p->setVisible(false);
-        }
+    // Fragments touchés par la lame : relancés avec la vitesse du sabre (pas de score)
+    const ProjectileSim& frag = m_fragments.sim();
+    const ProjectileSim::Arrays& f = frag.data();
+    const QVector3D swordVel = (swordPos - prevSwordPos) / dt;
+    m_fragmentGrid.build(frag);
+    m_fragmentGrid.querySweptSegment(base0, tip0, base1, tip1, Sword::kBladeHalfWidth, m_candidates);
+    for (int i : m_candidates) {
+        const QVector3D prevPos(f.prevX[i], f.prevY[i], f.prevZ[i]);
+        const QVector3D pos(f.px[i], f.py[i], f.pz[i]);
+        if (segmentSegmentDistance(toSim(prevPos - prevSwordPos), toSim(pos - swordPos), base, tip)
+                >= 0.5f * f.size[i] + Sword::kBladeHalfWidth)
+            continue;
+        const ProjectileSim::Vec3 v = frag.velocity(i);
+        ProjectileSim::Launch l;
+        l.shape    = f.shape[i];
+        l.start    = frag.position(i);
+        l.velocity = { v.x + swordVel.x(), v.y + swordVel.y(), v.z + swordVel.z() };
+        l.size     = f.size[i];
+        l.rot      = f.rot[i];
+        l.axis     = f.axis[i];
+        l.flags    = f.flags[i];
+        m_fragments.sim().launch(i, l);
     }
 
-    for (auto* p : m_projectiles) {
-        if (!p->isActive()) {
+    for (int i = 0; i < int(m_sim.size()); ++i) {
+        if (!m_sim.isActive(i)) {
             float rx = randomX(-5.f, 5.f);
-            p->setShape(Projectile::RandomShape());
-            p->reset({rx, 0.f, -5.f}, {0.f, 0.f, 12.f});
-            p->setActive(true);
-            p->setVisible(true);
+            m_sim.respawn(i, int(Projectile::RandomShape()), {rx, 0.f, -5.f}, {0.f, 0.f, 12.f});
         }
     }
-
-    update();
-}
-
-
-void GameScene::update()
-{
-    float dt = m_elapsed.restart() * 1e-3f;
-
-    for (auto* p : m_projectiles)
-    {
-        p->advanceTime(dt);
-    }
-
-    QOpenGLWidget::update();
 }
 
 
@@ -440,8 +562,12 @@ GameScene::~GameScene()
     m_groundTexture.reset();
     m_ceillingTexture.reset();
     m_frontTexture.reset();
-    qDeleteAll(m_projectiles);
+    MeshRegistry::instance().destroy();
+    m_particles.destroy();
+    m_sceneUniforms.destroy();
+    TextureCache::instance().destroy();
     delete m_shader;
+    delete m_instancedShader;
     doneCurrent();
 }
 
@@ -456,11 +582,18 @@ void GameScene::initializeGL()
     initializeOpenGLFunctions();
     glEnable(GL_DEPTH_TEST);
 
-    initShader();
+    m_sceneUniforms.initialize();
+    // Échec : le reste de l’init continue (sabre, simulation), paintGL se contente d’effacer
+    m_glFailed = !initShader();
+    if (m_glFailed)
+        qWarning() << "GameScene: compilation/link des shaders échoué, rendu désactivé";
     uploadSceneLight();
 
-    m_particleVbo.create();
-    m_particleVbo.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    // Meshes et textures de projectiles chargés une fois pour toute la partie
+    MeshRegistry::instance().initialize();
+    TextureCache::instance().initialize();
+
+    m_particles.initialize(m_sceneUniforms);
     setupRoom();
     m_sword = new Sword(this);
     m_sword->initialize();
@@ -472,33 +605,35 @@ void GameScene::initializeGL()
 
 
 
-    m_audioOutput = new QAudioOutput(this);
-    m_musicPlayer = new QMediaPlayer(this);
-    m_musicPlayer->setAudioOutput(m_audioOutput);
-    m_musicPlayer->setSource(QUrl::fromLocalFile("C:/Users/khali/dev/sd lakheeer/assets/music.mp3"));
-    m_audioOutput->setVolume(0.3);
-    m_musicPlayer->play();
-
-    m_sfxOutput = new QAudioOutput(this);
-    m_sfxPlayer = new QMediaPlayer(this);
-    m_sfxPlayer->setAudioOutput(m_sfxOutput);
-    m_sfxPlayer->setSource(QUrl::fromLocalFile("C:/Users/khali/dev/sd lakheeer/assets/cut.mp3"));
-    m_sfxOutput->setVolume(1.0);
+    // Sans son en mode headless (serveurs sans périphérique audio)
+    if (m_audioEnabled) {
+        m_audioOutput = new QAudioOutput(this);
+        m_musicPlayer = new QMediaPlayer(this);
+        m_musicPlayer->setAudioOutput(m_audioOutput);
+        m_musicPlayer->setSource(QUrl::fromLocalFile("C:/Users/khali/dev/sd lakheeer/assets/music.mp3"));
+        m_audioOutput->setVolume(0.3);
+        m_musicPlayer->play();
 
+        m_sfxOutput = new QAudioOutput(this);
+        m_sfxPlayer = new QMediaPlayer(this);
+        m_sfxPlayer->setAudioOutput(m_sfxOutput);
+        m_sfxPlayer->setSource(QUrl::fromLocalFile("C:/Users/khali/dev/sd lakheeer/assets/cut.mp3"));
+        m_sfxOutput->setVolume(1.0);
+    }
 
 
-    float rx = randomX(-5.f, 5.f);
-    Projectile::Settings cfg;
-    cfg.shape           = Projectile::RandomShape();
-    cfg.initialPosition = { rx, 0.f, -5.f };
-    cfg.targetPoint     = { 0.f, 0.f, 12.f };
-    cfg.size            = 1.f;
-    cfg.velocity        = {};
-
-
-    m_projectiles.append( new Projectile(cfg));
 
+    // Appels de mise en place comptés par CountingFunctions : hors première frame
+    glstats::endFrame();
 
+    m_sim.reserve(m_projectileCount);
+    for (auto* batches : { &m_instanceBatches, &m_fragmentBatches })
+        for (auto& batch : *batches)
+            batch.reserve(qMax(m_projectileCount, m_fragments.capacity()));
+    for (int i = 0; i < m_projectileCount; ++i) {
+        float rx = randomX(-5.f, 5.f);
+        m_sim.add(int(Projectile::RandomShape()), { rx, 0.f, -5.f }, { 0.f, 0.f, 12.f }, 1.f);
+    }
 }
 
 
@@ -510,43 +645,29 @@ void GameScene::resizeGL(int w, int h)
 }
 void GameScene::drawRoom()
 {
-    m_shader->bind();
-    m_roomVao.bind();
-
-
-    m_shader->setUniformValue("uEmissionColor", QVector3D(0.f, 0.f, 0.f));
-    m_shader->setUniformValue("uEmissionPower", 0.0f);
-
-
-    QMatrix4x4 I;  I.setToIdentity();
-    m_shader->setUniformValue("uModel", I);
-    m_shader->setUniformValue("uView",  m_view);
-    m_shader->setUniformValue("uProj",  m_proj);
-    m_shader->setUniformValue("uHasTex", 1);
-    m_shader->setUniformValue("uTexture", 0);
-
-    if (m_ceillingTexture) m_ceillingTexture->bind(0);
+    // Programme de scène lié par paintGL ; vue/proj/lumière viennent de l’UBO
+    const QMatrix4x4 model;
+    const QMatrix3x3 normal;
+    glBindVertexArray(m_roomVao.objectId());
+    glUniformMatrix4fv(m_sceneLoc.model, 1, GL_FALSE, model.constData());
+    glUniformMatrix3fv(m_sceneLoc.normalMatrix, 1, GL_FALSE, normal.constData());
+    glUniform1i(m_sceneLoc.hasTex, 1);
+    glActiveTexture(GL_TEXTURE0);
+
+    if (m_ceillingTexture) glBindTexture(GL_TEXTURE_2D, m_ceillingTexture->textureId());
     glDrawArrays(GL_TRIANGLES, 0, 6);
 
-
-    if (m_groundTexture) m_groundTexture->bind(0);
+    if (m_groundTexture) glBindTexture(GL_TEXTURE_2D, m_groundTexture->textureId());
     glDrawArrays(GL_TRIANGLES, 6, 6);
 
-
-    if (m_frontTexture) m_frontTexture->bind(0);
+    if (m_frontTexture) glBindTexture(GL_TEXTURE_2D, m_frontTexture->textureId());
     glDrawArrays(GL_TRIANGLES, 12, 6);
 
+    // Les deux murs latéraux sont contigus et partagent la texture : une seule draw
+    if (m_wallTexture) glBindTexture(GL_TEXTURE_2D, m_wallTexture->textureId());
+    glDrawArrays(GL_TRIANGLES, 18, 12);
 
-    if (m_wallTexture) m_wallTexture->bind(0);
-    glDrawArrays(GL_TRIANGLES, 18, 6);
-
-
-    if (m_wallTexture) m_wallTexture->bind(0);
-    glDrawArrays(GL_TRIANGLES, 24, 6);
-
-
-    m_roomVao.release();
-    m_shader->release();
+    glBindVertexArray(0);
 }
 
 void GameScene::paintEvent(QPaintEvent* event)
@@ -567,8 +688,19 @@ void GameScene::paintEvent(QPaintEvent* event)
 
 
 void GameScene::paintGL()
+{
+    const perf::ScopedTimer timer(perf::Paint);
+    paintFrame();
+
+    // Relevé à chaque frame, écran de fin et échec shader compris
+    const glstats::Frame stats = glstats::endFrame();
+    emit glStatsChanged(stats.calls, stats.draws);
+}
+
+void GameScene::paintFrame()
 {
     if (m_gameOver) {
+        m_pendingLatency = LatencyStamp();   // Sabre non dessiné
         glClearColor(0.f, 0.f, 0.f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -595,7 +727,18 @@ void GameScene::paintGL()
     }
 
 
+    if (m_phaseTiming) {
+        // Le travail GL en attente ne doit pas être imputé à la première phase
+        glFinish();
+        m_phaseClock.start();
+        m_phaseLastNs = 0;
+    }
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (m_glFailed) {
+        m_pendingLatency = LatencyStamp();   // Sabre non dessiné
+        return;
+    }
 
 
     static float camTime = 0.f;
@@ -607,27 +750,128 @@ void GameScene::paintGL()
     m_view.setToIdentity();
     m_view.lookAt(eye, center, {0.f, 1.f, 0.f});
 
-    m_shader->bind();
-    m_shader->setUniformValue("uViewPos", eye);
-    m_shader->release();
+    // Vue, projection, lumière et caméra : un upload pour toute la frame
+    m_sceneUniforms.update(m_view, m_proj, m_lightDir.normalized(), eye);
 
+    // Salle, grille et sabre partagent le programme de scène : un seul bind
+    glUseProgram(m_shader->programId());
+    endPhase(PhaseSetup);
     drawRoom();
+    endPhase(PhaseRoom);
     drawCylinderGrid();
+    endPhase(PhaseGrid);
 
     glDepthMask(GL_TRUE);
     glDisable(GL_BLEND);
     glEnable(GL_CULL_FACE);
 
-    m_shader->bind();
-    for (const Explosion& boom : m_explosions)
-        drawExplosionParticles(boom);
+    m_sword->render(m_sceneLoc);
+    endPhase(PhaseSword);
 
-    m_sword->render(*m_shader, m_view, m_proj);
-    m_shader->release();
+    drawProjectilesInstanced();
+    endPhase(PhaseProjectiles);
+
+    // Transparents en dernier ; temps au même instant interpolé que les projectiles
+    m_particles.render(float(m_simTime - (1.0 - m_renderAlpha) * m_simStep));
+    endPhase(PhaseParticles);
 
-    for (auto* p : m_projectiles) {
-        if (!p->isVisible()) continue;
-        p->render(*m_shader, m_view, m_proj);
+    // Fin de soumission de la frame qui dessine le sabre (hors présentation / vsync)
+    if (m_latencyProbe && m_pendingLatency.grabNs != 0) {
+        m_latencyProbe->add(m_pendingLatency, latencyNow());
+        m_pendingLatency = LatencyStamp();
+    }
+}
+
+const char* GameScene::renderPhaseName(int phase)
+{
+    static const char* const names[kRenderPhaseCount] = {
+        "setup", "room", "grid", "sword", "projectiles", "particles"
+    };
+    return (phase >= 0 && phase < kRenderPhaseCount) ? names[phase] : "?";
+}
+
+void GameScene::endPhase(RenderPhase phase)
+{
+    if (!m_phaseTiming)
+        return;
+    // glFinish : la durée de la phase inclut l’exécution GPU, pas seulement la soumission
+    glFinish();
+    const qint64 now = m_phaseClock.nsecsElapsed();
+    m_phaseNs[phase] = now - m_phaseLastNs;
+    m_phaseLastNs    = now;
+}
+
+void GameScene::drawProjectilesInstanced()
+{
+    // Regroupe les objets visibles par forme (buffers réutilisés d’une frame à l’autre)
+    collectInstances(m_sim, m_instanceBatches);
+    collectInstances(m_fragments.sim(), m_fragmentBatches);
+
+    glUseProgram(m_instancedShader->programId());
+    glActiveTexture(GL_TEXTURE0);
+
+    drawInstanceBatches(m_instanceBatches, false);
+    drawInstanceBatches(m_fragmentBatches, true);
+
+    glUseProgram(0);
+}
+
+void GameScene::collectInstances(const ProjectileSim& sim, InstanceBatches& batches) const
+{
+    for (auto& batch : batches)
+        batch.clear();
+
+    const ProjectileSim::Arrays& a = sim.data();
+    for (int i = 0; i < int(sim.size()); ++i) {
+        if (!sim.isActive(i) || !sim.isVisible(i))
+            continue;
+        const ProjectileSim::Vec3 p = sim.interpolatedPosition(i, m_renderAlpha);
+        QMatrix4x4 model;
+        model.translate(p.x, p.y, p.z);
+        model.rotate(sim.interpolatedAngle(i, m_renderAlpha), Projectile::kAxes[a.axis[i]]);
+        if (a.flags[i] & ProjectileSim::Mirrored)
+            model.rotate(180.f, 0.f, 1.f, 0.f);   // Moitié x >= 0 → moitié x <= 0
+        model.scale(a.size[i]);
+
+        ProjectileInstance inst;
+        std::copy(model.constData(), model.constData() + 16, inst.model);
+        const QMatrix3x3 normal = model.normalMatrix();
+        std::copy(normal.constData(), normal.constData() + 9, inst.normal);
+        batches[a.shape[i]].push_back(inst);
+    }
+}
+
+void GameScene::drawInstanceBatches(const InstanceBatches& batches, bool halfMeshes)
+{
+    for (int s = 0; s < Projectile::kShapeCount; ++s) {
+        const std::vector<ProjectileInstance>& batch = batches[s];
+        if (batch.empty())
+            continue;
+
+        const auto shape = static_cast<Projectile::Shape>(s);
+        ProjectileMesh* mesh = halfMeshes ? MeshRegistry::instance().halfMesh(shape)
+                                          : MeshRegistry::instance().mesh(shape);
+        if (!mesh)
+            continue;
+
+        // Orphaning du buffer puis écriture : pas d’attente sur la frame précédente
+        const int bytes = static_cast<int>(batch.size() * sizeof(ProjectileInstance));
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->instanceVbo.bufferId());
+        if (bytes > mesh->instanceCapacity)
+            mesh->instanceCapacity = bytes * 2;
+        glBufferData(GL_ARRAY_BUFFER, mesh->instanceCapacity, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, batch.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        QOpenGLTexture* tex = TextureCache::instance().texture(TextureCache::layerFor(shape));
+        glUniform1i(m_instancedLoc.hasTex, tex ? 1 : 0);
+        if (tex) glBindTexture(GL_TEXTURE_2D, tex->textureId());
+
+        glBindVertexArray(mesh->vao.objectId());
+        glDrawArraysInstanced(GL_TRIANGLES, 0, mesh->vertexCount, static_cast<GLsizei>(batch.size()));
+        glBindVertexArray(0);
+
+        if (tex) glBindTexture(GL_TEXTURE_2D, 0);
     }
 }
 
@@ -636,14 +880,33 @@ bool GameScene::initShader()
     m_shader = new QOpenGLShaderProgram(this);
     if (!m_shader->addShaderFromSourceCode(QOpenGLShader::Vertex,   vShaderSrc)) return false;
     if (!m_shader->addShaderFromSourceCode(QOpenGLShader::Fragment, fShaderSrc)) return false;
-    return m_shader->link();
+    if (!m_shader->link()) return false;
+
+    m_instancedShader = new QOpenGLShaderProgram(this);
+    if (!m_instancedShader->addShaderFromSourceCode(QOpenGLShader::Vertex,   vInstancedShaderSrc)) return false;
+    if (!m_instancedShader->addShaderFromSourceCode(QOpenGLShader::Fragment, fShaderSrc)) return false;
+    if (!m_instancedShader->link()) return false;
+
+    // Emplacements résolus une fois, blocs reliés à l’UBO de scène
+    m_sceneLoc.resolve(*m_shader);
+    m_instancedLoc.resolve(*m_instancedShader);
+    return m_sceneUniforms.attach(*m_shader) && m_sceneUniforms.attach(*m_instancedShader);
 }
 
 void GameScene::uploadSceneLight()
 {
-    m_shader->bind();
-    m_shader->setUniformValue("uLightDir", QVector3D(1,1,1).normalized());
-    m_shader->setUniformValue("uShininess", 64.0f);
-    m_shader->release();
-
+    // Uniforms constants de la partie, posés une fois (la lumière passe par l’UBO)
+    const std::pair<QOpenGLShaderProgram*, const ShaderLocations*> programs[] = {
+        { m_shader, &m_sceneLoc }, { m_instancedShader, &m_instancedLoc }
+    };
+    for (const auto& [prog, loc] : programs) {
+        if (!prog || !prog->isLinked())
+            continue;   // initShader a échoué avant ce programme
+        prog->bind();
+        prog->setUniformValue("uShininess", 64.0f);
+        prog->setUniformValue(loc->texture, 0);
+        prog->setUniformValue(loc->emissionColor, QVector3D(0.f, 0.f, 0.f));
+        prog->setUniformValue(loc->emissionPower, 0.0f);
+        prog->release();
+    }
 }
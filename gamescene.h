@@ -4,7 +4,7 @@
 // Gère la boucle de jeu, l’init OpenGL, le rendu et la logique de la scène (meh, c’est le cœur du game)
 
 #include <QOpenGLWidget>
-#include <QOpenGLFunctions_3_3_Core>
+#include "glstats.h"
 #include <QMatrix4x4>
 #include <QElapsedTimer>
 #include <QTimer>
@@ -15,16 +15,20 @@
 #include <QPaintEvent>
 #include <QResizeEvent>
 #include "Sword.h"
-
-// Décrit un effet d’explosion à un point donné
-struct Explosion {
-    QVector3D position;
-};
+#include "meshregistry.h"
+#include "projectilesim.h"
+#include "broadphase.h"
+#include "fragmentpool.h"
+#include "particlesystem.h"
+#include "sceneuniforms.h"
+#include "latencyprobe.h"
+#include <array>
+#include <vector>
 
 class QOpenGLShaderProgram;
 
 class GameScene : public QOpenGLWidget,
-                  protected QOpenGLFunctions_3_3_Core
+                  protected glstats::CountingFunctions
 {
     Q_OBJECT
 
@@ -32,25 +36,53 @@ signals:
     // Signaux Qt pour notifier les changements
     void scoreChanged(int newScore);        // Quand le score évolue
     void elapsedTimeChanged(float seconds); // Quand le chrono update
+    void glStatsChanged(int calls, int draws); // Appels GL / draws émis par la dernière frame (cf. glstats.h)
 
 public:
     //=== Constructeur / Destructeur ===
     explicit GameScene(QWidget* parent = nullptr); // Prépare le widget
     ~GameScene() override;                         // Clean up GL & objets
 
+    // Nombre de projectiles lancés simultanément (à fixer avant initializeGL)
+    void setProjectileCount(int n) { m_projectileCount = qMax(1, n); }
+    int  projectileCount() const   { return m_projectileCount; }
+
+    // Fréquence de la simulation à pas fixe, indépendante du rythme de rendu
+    void   setSimulationHz(double hz) { m_simStep = 1.0 / qBound(10.0, hz, 1000.0); }
+    double simulationHz() const       { return 1.0 / m_simStep; }
+
+    // Musique et bruitages (à fixer avant initializeGL ; coupés en mode headless)
+    void setAudioEnabled(bool on) { m_audioEnabled = on; }
+
+    //=== Chrono par phase de rendu (RenderBench) ===
+    enum RenderPhase { PhaseSetup, PhaseRoom, PhaseGrid, PhaseSword,
+                       PhaseProjectiles, PhaseParticles, kRenderPhaseCount };
+    static const char* renderPhaseName(int phase);
+    // Si actif, paintGL fait un glFinish après chaque phase pour la chronométrer
+    void setPhaseTiming(bool on) { m_phaseTiming = on; }
+    const std::array<qint64, kRenderPhaseCount>& lastPhaseNs() const { return m_phaseNs; }
+
+    // Mesure main → sabre : chaque position horodatée est relevée à la fin du paintGL
+    // qui la dessine (nullptr = désactivé ; histogramme non possédé)
+    void setLatencyProbe(LatencyHistogram* probe) { m_latencyProbe = probe; }
+
+    // Pilote initializeGL / advance / paintGL hors widget (contexte hors écran)
+    friend class RenderBench;
+
 protected:
     //=== Overrides Qt / OpenGL ===
     void initializeGL() override;                  // Init contexte GL + shaders + assets
     void resizeGL(int w, int h) override;          // Ajuste la projection si la fenêtre change
-    void paintGL() override;                       // Rendu frame par frame
+    void paintGL() override;                       // Rendu frame par frame, puis publie glstats
     void paintEvent(QPaintEvent *event) override;  // Dessin Qt (GAME OVER overlay)
     void resizeEvent(QResizeEvent* event) override;// Gère le repositionnement UI
 
     //=== Scène / Rendu complémentaires ===
     void setupRoom();          // Génère sol, murs, plafond
-    void drawRoom();           // Dessine la room texturée
+    void drawRoom();           // Dessine la room texturée (m_shader déjà lié)
+    void paintFrame();         // Corps de paintGL (toutes ses sorties passent par endFrame)
     void setupCylinderGrid();  // Génère le grille cylindre (lines)
-    void drawCylinderGrid();   // Affiche la grille
+    void drawCylinderGrid();   // Affiche la grille (m_shader déjà lié)
 
 private:
     //=== État du jeu ===
@@ -58,6 +90,7 @@ private:
     bool        m_gameOver    = false;
     int         m_score       = 0;
     bool        m_hideInTunnel= false;  // si on doit planquer les projectiles dans le tunnel
+    bool        m_audioEnabled= true;
 
     QPushButton* m_startButton   = nullptr; // Bouton “Start Game”
     QPushButton* m_restartButton = nullptr; // Bouton “Restart Game”
@@ -67,6 +100,23 @@ private:
     QElapsedTimer m_elapsed;     // Delta time entre frames
     QTimer*       m_frameTimer;  // Timer Qt pour boucle à ~60fps
 
+    //=== Simulation à pas fixe ===
+    double        m_simStep     = 1.0 / 60.0; // Durée d’un pas (s)
+    double        m_accumulator = 0.0;        // Temps réel pas encore simulé
+    float         m_renderAlpha = 1.f;        // Fraction du pas en cours (interpolation)
+    double        m_simTime     = 0.0;        // Temps simulé depuis le début de la partie (s)
+    static constexpr int kMaxStepsPerTick = 8; // Au-delà, on lâche du temps (anti spirale)
+
+    //=== Chrono par phase (désactivé en jeu) ===
+    bool          m_phaseTiming = false;
+    QElapsedTimer m_phaseClock;
+    qint64        m_phaseLastNs = 0;
+    std::array<qint64, kRenderPhaseCount> m_phaseNs{};
+
+    //=== Mesure de latence (désactivée en jeu) ===
+    LatencyHistogram* m_latencyProbe = nullptr;
+    LatencyStamp      m_pendingLatency;   // Dernière position reçue, pas encore dessinée
+
     //=== Son ===
     QMediaPlayer* m_musicPlayer = nullptr; // Musique de fond
     QAudioOutput* m_audioOutput = nullptr;
@@ -74,11 +124,34 @@ private:
     QAudioOutput* m_sfxOutput   = nullptr;
 
     //=== Projetiles & explosions ===
-    QVector<Projectile*> m_projectiles; // Liste des projectiles actifs
-    QVector<Explosion>   m_explosions;  // Positions des explosions
+    ProjectileSim        m_sim;         // État SoA de tous les projectiles
+    UniformGrid          m_grid{ {-5.f, 0.f, -5.f}, {5.f, 5.f, 12.f}, 1.f }; // Broadphase (bornes de la salle)
+    UniformGrid          m_fragmentGrid{ {-5.f, 0.f, -5.f}, {5.f, 5.f, 12.f}, 1.f }; // Broadphase des fragments
+    FragmentPool         m_fragments;   // Moitiés de fruits coupés (capacité fixe)
+    std::vector<int>     m_candidates;  // Résultat des requêtes broadphase (réutilisé)
+    QVector3D            m_prevSwordPos;// Position du sabre au pas précédent (volume balayé)
+
+    //=== Historique des positions du sabre (une entrée par frame caméra) ===
+    struct SwordSample { qint64 ms; QVector3D pos; };
+    static constexpr int kSwordHistory = 8;
+    std::array<SwordSample, kSwordHistory> m_swordHistory{};
+    int                  m_swordHistoryCount = 0;
+    int                  m_swordHistoryHead  = 0;   // Prochaine case écrite
+    qint64               m_lastTickMs        = 0;   // Horloge de jeu au tick précédent
+    int                  m_projectileCount = 1; // Taille de la vague
+
+    // Instances par forme, remplies à chaque frame pour le rendu instancié
+    using InstanceBatches = std::array<std::vector<ProjectileInstance>, Projectile::kShapeCount>;
+    InstanceBatches      m_instanceBatches;
+    InstanceBatches      m_fragmentBatches;  // Idem pour les demi-meshes des fragments
 
     //=== Ressources OpenGL générales ===
-    QOpenGLShaderProgram*      m_shader   = nullptr; // Shader unique
+    QOpenGLShaderProgram*      m_shader   = nullptr; // Shader principal
+    QOpenGLShaderProgram*      m_instancedShader = nullptr; // Variante instanciée (projectiles)
+    bool                       m_glFailed = false; // initShader a échoué : paintGL n’efface que l’écran
+    SceneUniforms              m_sceneUniforms;  // UBO vue/proj/lumière, une mise à jour par frame
+    ShaderLocations            m_sceneLoc;       // Emplacements des uniforms par draw (m_shader)
+    ShaderLocations            m_instancedLoc;   // Idem pour m_instancedShader
     QMatrix4x4                 m_proj;               // Matrice de projection
     QMatrix4x4                 m_view;               // Matrice de vue (caméra)
 
@@ -97,7 +170,7 @@ private:
     int                        m_cylinderVertexCount = 0;
 
     //=== Particules explosion ===
-    QOpenGLBuffer              m_particleVbo{QOpenGLBuffer::VertexBuffer};
+    ParticleSystem             m_particles;   // Émetteurs vivants en tête, animés sur GPU
 
     //=== Éclairage ===
     QVector3D                  m_lightDir = { 1.f, 1.f, 1.f }; // Direction light
@@ -109,13 +182,23 @@ private:
     const float g = 9.81f;
 
     //=== Fonctions utilitaires privées ===
-    void tick();                          // Update loop: game logic + collisions
+    void tick();                          // Mesure le temps réel écoulé puis advance()
+    // Accumule seconds et lance les pas fixes ; ils se répartissent [m_lastTickMs, nowMs]
+    // de l’horloge de jeu (historique du sabre), puis fixe l’interpolation du rendu
+    void advance(double seconds, qint64 nowMs);
+    void recordSwordSample(const QVector3D& pos, qint64 ms); // Sabre déplacé + historique
+    void simulateStep(float dt, const QVector3D& swordPos); // Un pas : trajectoires, collisions, respawn
+    QVector3D swordPositionAt(qint64 ms) const;               // Interpolée dans l’historique
+    void restartClock();                  // Repart d’un accumulateur vide
+    void restartGame();                   // Score, projectiles, fragments et particules remis à zéro
+    void endPhase(RenderPhase phase);     // Clôt la phase en cours (si chrono par phase actif)
     bool initShader();                    // Compile/link shaders
-    void uploadSceneLight();              // Envoie params light au shader
-    void update();                        // Force update OpenGLWidget
-    void drawExplosionParticles(const Explosion& ex); // Render points explosion
+    void uploadSceneLight();              // Uniforms constants (brillance, unité de texture, émission)
+    void drawProjectilesInstanced();      // Une draw instanciée par forme (fruits puis fragments)
+    void collectInstances(const ProjectileSim& sim, InstanceBatches& batches) const;
+    void drawInstanceBatches(const InstanceBatches& batches, bool halfMeshes);
 
 public slots:
-    // Slot pour bouger le sabre depuis UI externe
-    void updateSwordPosition(const QVector3D& pos);
+    // Slot pour bouger le sabre depuis UI externe (stamp : horodatage de la frame caméra)
+    void updateSwordPosition(const QVector3D& pos, const LatencyStamp& stamp = LatencyStamp());
 };
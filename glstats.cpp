@@ -0,0 +1,25 @@
+#include "glstats.h"
+
+namespace glstats {
+
+static Frame s_frame;
+
+void count(int calls)
+{
+    s_frame.calls += calls;
+}
+
+void countDraw()
+{
+    ++s_frame.calls;
+    ++s_frame.draws;
+}
+
+Frame endFrame()
+{
+    const Frame done = s_frame;
+    s_frame = Frame();
+    return done;
+}
+
+} // namespace glstats
@@ -0,0 +1,78 @@
+#ifndef GLSTATS_H
+#define GLSTATS_H
+
+#include <QOpenGLFunctions_3_3_Core>
+
+/*
+ * Compteur d’appels GL par frame (thread GUI uniquement).
+ * → Les classes de rendu (GameScene, Sword, ParticleSystem, SceneUniforms) héritent
+ *   de glstats::CountingFunctions au lieu de QOpenGLFunctions_3_3_Core : chaque point
+ *   d’entrée émis par frame y est masqué par une version qui compte puis transmet.
+ *   calls et draws sont donc relevés sur les appels réellement émis.
+ * → Le chemin par frame appelle GL directement, sans passer par les wrappers Qt
+ *   (QOpenGLShaderProgram::bind, setUniformValue, QOpenGLBuffer, QOpenGLTexture::bind,
+ *   QOpenGLVertexArrayObject::bind), qui émettent par leurs propres fonctions.
+ * → Non comptés : les appels de Qt lui-même (FBO et états de QOpenGLWidget, QPainter
+ *   de l’écran de fin) et les glFinish des mesures de phases (--render-bench).
+ * → GameScene relève les totaux en fin de paintGL (endFrame) et les publie.
+ */
+namespace glstats {
+
+struct Frame {
+    int calls = 0;   // Appels GL émis pendant la frame (draws compris)
+    int draws = 0;   // glDraw*
+};
+
+void  count(int calls = 1);   // Appels GL émis (CountingFunctions)
+void  countDraw();            // Un glDraw* (compté aussi dans calls)
+Frame endFrame();             // Totaux de la frame écoulée, puis remise à zéro
+
+/*
+ * Classe CountingFunctions :
+ * → QOpenGLFunctions_3_3_Core dont les fonctions utilisées par frame comptent leurs
+ *   appels. Les appels non qualifiés d’une classe dérivée trouvent ces versions en
+ *   premier ; une fonction absente d’ici n’est pas comptée : l’ajouter avant de
+ *   l’utiliser dans un chemin de rendu.
+ */
+class CountingFunctions : public QOpenGLFunctions_3_3_Core
+{
+    using Base = QOpenGLFunctions_3_3_Core;
+
+public:
+    //=== États ==================================================================
+    void glClear(GLbitfield mask)                             { count(); Base::glClear(mask); }
+    void glClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) { count(); Base::glClearColor(r, g, b, a); }
+    void glEnable(GLenum cap)                                 { count(); Base::glEnable(cap); }
+    void glDisable(GLenum cap)                                { count(); Base::glDisable(cap); }
+    void glDepthMask(GLboolean flag)                          { count(); Base::glDepthMask(flag); }
+    void glBlendFunc(GLenum sfactor, GLenum dfactor)          { count(); Base::glBlendFunc(sfactor, dfactor); }
+    void glLineWidth(GLfloat width)                           { count(); Base::glLineWidth(width); }
+
+    //=== Programmes et uniforms =================================================
+    void glUseProgram(GLuint program)                         { count(); Base::glUseProgram(program); }
+    void glUniform1i(GLint location, GLint v0)                { count(); Base::glUniform1i(location, v0); }
+    void glUniform1f(GLint location, GLfloat v0)              { count(); Base::glUniform1f(location, v0); }
+    void glUniformMatrix3fv(GLint location, GLsizei n, GLboolean transpose, const GLfloat* value)
+    { count(); Base::glUniformMatrix3fv(location, n, transpose, value); }
+    void glUniformMatrix4fv(GLint location, GLsizei n, GLboolean transpose, const GLfloat* value)
+    { count(); Base::glUniformMatrix4fv(location, n, transpose, value); }
+
+    //=== Textures, buffers, VAO =================================================
+    void glActiveTexture(GLenum texture)                      { count(); Base::glActiveTexture(texture); }
+    void glBindTexture(GLenum target, GLuint texture)         { count(); Base::glBindTexture(target, texture); }
+    void glBindBuffer(GLenum target, GLuint buffer)           { count(); Base::glBindBuffer(target, buffer); }
+    void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+    { count(); Base::glBufferData(target, size, data, usage); }
+    void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+    { count(); Base::glBufferSubData(target, offset, size, data); }
+    void glBindVertexArray(GLuint array)                      { count(); Base::glBindVertexArray(array); }
+
+    //=== Draws ==================================================================
+    void glDrawArrays(GLenum mode, GLint first, GLsizei n)    { countDraw(); Base::glDrawArrays(mode, first, n); }
+    void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei n, GLsizei instances)
+    { countDraw(); Base::glDrawArraysInstanced(mode, first, n, instances); }
+};
+
+} // namespace glstats
+
+#endif // GLSTATS_H
@@ -0,0 +1,50 @@
+#include "latencyprobe.h"
+#include "samplestats.h"
+#include <algorithm>
+
+namespace {
+
+double toMs(std::int64_t ns) { return ns * 1e-6; }
+
+void writeRow(std::ostream& out, const char* stage, const std::vector<double>& values)
+{
+    if (values.empty()) {
+        out << stage << ",0,,,,,\n";
+        return;
+    }
+    const samplestats::Summary s = samplestats::summarize(values);
+    out << stage << ',' << s.count << ',' << s.mean << ','
+        << s.p50 << ',' << s.p95 << ',' << s.p99 << ',' << s.max << '\n';
+}
+
+} // namespace
+
+void LatencyHistogram::add(const LatencyStamp& stamp, std::int64_t paintedNs)
+{
+    if (stamp.grabNs == 0 || stamp.detectedNs == 0 || stamp.swordNs == 0)
+        return;
+
+    m_detect.push_back(toMs(stamp.detectedNs - stamp.grabNs));
+    m_gui.push_back   (toMs(stamp.swordNs    - stamp.detectedNs));
+    m_render.push_back(toMs(paintedNs        - stamp.swordNs));
+
+    const double total = toMs(paintedNs - stamp.grabNs);
+    m_total.push_back(total);
+    ++m_buckets[std::clamp(int(total), 0, kBuckets - 1)];
+}
+
+void LatencyHistogram::write(std::ostream& out) const
+{
+    out << "stage,samples,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+    writeRow(out, "capture_to_detection", m_detect);
+    writeRow(out, "detection_to_sword",   m_gui);
+    writeRow(out, "sword_to_paint",       m_render);
+    writeRow(out, "total",                m_total);
+
+    // Histogramme borné à la dernière tranche non vide
+    int last = kBuckets - 1;
+    while (last > 0 && m_buckets[last] == 0) --last;
+    out << "\nbucket_ms,count\n";
+    for (int b = 0; b <= last; ++b)
+        out << b << ',' << m_buckets[b] << '\n';
+}
@@ -0,0 +1,55 @@
+#ifndef LATENCYPROBE_H
+#define LATENCYPROBE_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/*
+ * Horodatages d’une frame caméra le long du chemin main → sabre (steady_clock, ns).
+ * 0 = étape non atteinte.
+ */
+struct LatencyStamp {
+    std::int64_t grabNs     = 0;   // Frame lue par le thread de capture
+    std::int64_t detectedNs = 0;   // Résultat publié par le thread de détection
+    std::int64_t swordNs    = 0;   // GameScene::updateSwordPosition (thread GUI)
+};
+
+inline std::int64_t latencyNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Classe LatencyHistogram :
+ * → Une mesure par position de sabre effectivement rendue (fin de paintGL), découpée
+ *   en capture → détection, détection → sabre (attente du timer GUI), sabre → rendu.
+ * → Histogramme de la latence totale par tranches de 1 ms (dernière tranche = au-delà).
+ * → Thread GUI uniquement.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int kBuckets = 200;   // [0, 1) … [198, 199) ms, puis ≥ 199 ms
+
+    void        add(const LatencyStamp& stamp, std::int64_t paintedNs);
+    std::size_t count() const { return m_total.size(); }
+
+    /**
+     * Écrit le résumé (stage,samples,mean_ms,p50_ms,p95_ms,p99_ms,max_ms) puis
+     * l’histogramme (bucket_ms,count) de la latence totale.
+     */
+    void write(std::ostream& out) const;
+
+private:
+    std::vector<double>         m_detect;   // grab → détection publiée
+    std::vector<double>         m_gui;      // détection → updateSwordPosition
+    std::vector<double>         m_render;   // updateSwordPosition → fin de paintGL
+    std::vector<double>         m_total;    // grab → fin de paintGL
+    std::array<int, kBuckets>   m_buckets{};
+};
+
+#endif // LATENCYPROBE_H
@@ -0,0 +1,50 @@
+#ifndef LATESTVALUE_H
+#define LATESTVALUE_H
+
+#include <atomic>
+
+/*
+ * Classe LatestValue :
+ * → Boîte aux lettres "dernière valeur" lock-free (triple buffering).
+ * → Le producteur remplit back() puis publish() ; le consommateur appelle fetch()
+ *   et lit front(). Aucun des deux n’attend jamais l’autre, les valeurs
+ *   intermédiaires non lues sont simplement écrasées.
+ */
+template <typename T>
+class LatestValue
+{
+public:
+    //=== Côté producteur =======================================================
+    T& back() { return m_buffers[m_back]; }
+    // true si la valeur précédente n’avait pas été lue (écrasée)
+    bool publish()
+    {
+        const int prev = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel);
+        m_back = prev & kIndexMask;
+        return (prev & kFresh) != 0;
+    }
+
+    //=== Côté consommateur =====================================================
+    // true si une nouvelle valeur a été publiée depuis le dernier fetch()
+    bool fetch()
+    {
+        if (!(m_middle.load(std::memory_order_acquire) & kFresh))
+            return false;
+        const int prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & kIndexMask;
+        return true;
+    }
+    const T& front() const { return m_buffers[m_front]; }
+    T&       front()       { return m_buffers[m_front]; }  // Modifiable : possédé jusqu’au fetch() suivant
+
+private:
+    static constexpr int kIndexMask = 0x3;
+    static constexpr int kFresh     = 0x4;
+
+    T                m_buffers[3];
+    int              m_back  = 0;          // Possédé par le producteur
+    int              m_front = 2;          // Possédé par le consommateur
+    std::atomic<int> m_middle{1};          // Index échangé + bit "fresh"
+};
+
+#endif // LATESTVALUE_H
@@ -1,11 +1,158 @@
 #include "mainwindow.h"
+#include "scalereport.h"
+#include "renderbench.h"
+#include "alloccounter.h"
+#include "tracer.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <fstream>
+#include <iostream>
 
 int main(int argc, char *argv[])
 {
+    alloccount::install();   // No-op sans SDD_COUNT_ALLOCATIONS
     QApplication a(argc, argv);
-    MainWindow w;
-    w.show();
-    return a.exec();
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption sourceOpt(
+        "source",
+        "Frame source: camera:<id>, video:<path> or synthetic[:<w>x<h>[@<fps>]] "
+        "(synthetic runs at 30 FPS unless @<fps> is given, @0 = unthrottled).",
+        "spec", "camera:1");
+    parser.addOption(sourceOpt);
+    QCommandLineOption scaleReportOpt(
+        "scale-report",
+        "Print a detection accuracy-vs-speed CSV for each processing scale over <frames> frames, then exit.",
+        "frames");
+    parser.addOption(scaleReportOpt);
+    QCommandLineOption scaleOpt(
+        "scale",
+        "Palm detection processing scale (1, 0.5, 0.25...); the palm centre is refined at full resolution.",
+        "factor", "1");
+    parser.addOption(scaleOpt);
+    QCommandLineOption simHzOpt(
+        "sim-hz",
+        "Fixed simulation rate in Hz; rendering interpolates between simulation steps.",
+        "hz", "60");
+    parser.addOption(simHzOpt);
+    QCommandLineOption projectilesOpt(
+        "projectiles",
+        "Number of projectiles launched per wave (hundreds or thousands are drawn with instancing).",
+        "n", "1");
+    parser.addOption(projectilesOpt);
+    QCommandLineOption renderBenchOpt(
+        "render-bench",
+        "Render <frames> frames of a scripted scene headless (offscreen FBO) and print per-phase timings, then exit.",
+        "frames");
+    parser.addOption(renderBenchOpt);
+    QCommandLineOption benchProjectilesOpt(
+        "bench-projectiles",
+        "Number of projectiles in the --render-bench scene.",
+        "n", "50");
+    parser.addOption(benchProjectilesOpt);
+    QCommandLineOption benchSizeOpt(
+        "bench-size",
+        "Framebuffer size of --render-bench.",
+        "WxH", "1280x720");
+    parser.addOption(benchSizeOpt);
+    QCommandLineOption benchJsonOpt(
+        "bench-json",
+        "Print a JSON summary (mean, p50, p95, max per phase) instead of per-frame CSV.");
+    parser.addOption(benchJsonOpt);
+    QCommandLineOption perfOpt(
+        "perf",
+        "Show per-stage timings (capture, detection, tick, paint...) with rolling average and worst case in the side panel.");
+    parser.addOption(perfOpt);
+    QCommandLineOption perfDumpOpt(
+        "perf-dump",
+        "Write the retained per-stage timing samples to <file> (CSV) on exit.",
+        "file");
+    parser.addOption(perfDumpOpt);
+    QCommandLineOption traceOpt(
+        "trace",
+        "Record capture, detection stages, sword updates, ticks and paints with thread ids, "
+        "and write them to <file> as Chrome trace-event JSON on exit.",
+        "file");
+    parser.addOption(traceOpt);
+    QCommandLineOption latencyOpt(
+        "latency-probe",
+        "Measure motion-to-sword latency (frame grab to the paintGL that draws the sword) over <samples> "
+        "detected frames, print a summary and histogram as CSV, then exit.",
+        "samples");
+    parser.addOption(latencyOpt);
+    QCommandLineOption latencyTimeoutOpt(
+        "latency-timeout",
+        "With --latency-probe: give up after <seconds> (default 60), print what was collected and exit with status 1.",
+        "seconds", "60");
+    parser.addOption(latencyTimeoutOpt);
+    parser.process(a);
+
+    if (parser.isSet(scaleReportOpt)) {
+        return runScaleReport(parser.value(sourceOpt).toStdString(),
+                              PalmDetector::kDefaultCascadePath,
+                              parser.value(scaleReportOpt).toInt(),
+                              std::cout);
+    }
+
+    if (parser.isSet(renderBenchOpt)) {
+        RenderBench::Options bench;
+        bool framesOk = false, projectilesOk = false, widthOk = false, heightOk = false;
+        bench.frames       = parser.value(renderBenchOpt).toInt(&framesOk);
+        bench.projectiles  = parser.value(benchProjectilesOpt).toInt(&projectilesOk);
+        bench.simulationHz = parser.value(simHzOpt).toDouble();
+        bench.json         = parser.isSet(benchJsonOpt);
+        const QStringList size = parser.value(benchSizeOpt).split('x');
+        if (size.size() == 2) {
+            bench.width  = size[0].toInt(&widthOk);
+            bench.height = size[1].toInt(&heightOk);
+        }
+        // Valeurs négatives ou nulles : tailles de vecteurs et de FBO invalides
+        if (!framesOk || bench.frames <= 0) {
+            std::cerr << "--render-bench: <frames> must be a positive integer" << std::endl;
+            return 2;
+        }
+        if (!projectilesOk || bench.projectiles < 0) {
+            std::cerr << "--bench-projectiles: <n> must be zero or a positive integer" << std::endl;
+            return 2;
+        }
+        if (!widthOk || !heightOk || bench.width <= 0 || bench.height <= 0) {
+            std::cerr << "--bench-size: expected WxH with positive sizes, e.g. 1280x720" << std::endl;
+            return 2;
+        }
+        return RenderBench::run(bench, std::cout);
+    }
+
+    MainWindow::Options options;
+    options.source          = parser.value(sourceOpt);
+    options.processingScale = parser.value(scaleOpt).toDouble();
+    options.simulationHz    = parser.value(simHzOpt).toDouble();
+    options.projectileCount = parser.value(projectilesOpt).toInt();
+    options.perfOverlay     = parser.isSet(perfOpt);
+    options.perfDumpPath    = parser.value(perfDumpOpt);
+    options.latencySamples  = parser.value(latencyOpt).toInt();
+    options.latencyTimeoutSec = parser.value(latencyTimeoutOpt).toInt();
+
+    if (parser.isSet(traceOpt)) {
+        trace::start();
+        trace::setThreadName("gui");
+    }
+
+    int rc = 0;
+    {
+        MainWindow w(options);
+        w.show();
+        rc = a.exec();
+    }   // Threads de capture / détection / cascade joints : les tampons de trace sont figés
+
+    if (parser.isSet(traceOpt)) {
+        std::ofstream out(parser.value(traceOpt).toStdString());
+        if (!out) {
+            std::cerr << "Cannot write trace to " << parser.value(traceOpt).toStdString() << std::endl;
+            return 1;
+        }
+        std::cerr << trace::write(out) << " trace events written" << std::endl;
+    }
+    return rc;
 }
@@ -1,24 +1,36 @@
 #include "mainwindow.h"
 #include "camera_window.h"
 #include "gamescene.h"
+#include "perfprobe.h"
+#include "previewimage.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QMessageBox>
 #include <QImage>
-#include <QPixmap>
-#include <opencv2/imgproc.hpp>
 #include <QtMath>
-MainWindow::MainWindow(QWidget* parent)
+#include <QApplication>
+#include <iostream>
+#include <fstream>
+MainWindow::MainWindow(const Options& options, QWidget* parent)
     : QMainWindow(parent)
     , scene(nullptr)
     , sidePanel(nullptr)
     , sideLayout(nullptr)
     , cameraWindow(nullptr)
     , scoreLabel(nullptr)
+    , timeLabel(nullptr)
+    , glStatsLabel(nullptr)
+    , perfLabel(nullptr)
     , detector(nullptr)
+    , pipeline(nullptr)
     , timer(nullptr)
+    , perfTimer(nullptr)
+    , perfDumpPath(options.perfDumpPath)
+    , latencyTarget(options.latencySamples)
 {
+    perf::setEnabled(options.perfOverlay || !options.perfDumpPath.isEmpty());
+
     QWidget* central = new QWidget(this);
     setCentralWidget(central);
 
@@ -26,6 +38,14 @@ MainWindow::MainWindow(QWidget* parent)
     mainLay->setContentsMargins(0, 0, 0, 0);
 
     scene = new GameScene(this);
+    scene->setSimulationHz(options.simulationHz);
+    scene->setProjectileCount(options.projectileCount);   // Avant initializeGL (show)
+    if (latencyTarget > 0) {
+        scene->setLatencyProbe(&latency);
+        // Aucune paume détectée (source vide, mauvais cadrage…) : pas d’attente infinie
+        QTimer::singleShot(qMax(1, options.latencyTimeoutSec) * 1000, this,
+                           [this]{ finishLatencyProbe(false); });
+    }
     mainLay->addWidget(scene, /*stretch*/ 4);
 
     sidePanel = new QWidget(central);
@@ -35,7 +55,7 @@ MainWindow::MainWindow(QWidget* parent)
 
 
     cameraWindow = new CameraWindow(this);
-    sideLayout->addWidget(cameraWindow->label(), /*stretch*/ 1);
+    sideLayout->addWidget(cameraWindow->view(), /*stretch*/ 1);
 
 
     scoreLabel = new QLabel("Score: 0", sidePanel);
@@ -48,29 +68,58 @@ MainWindow::MainWindow(QWidget* parent)
     timeLabel->setStyleSheet("color: white; font: 14pt;");
     sideLayout->addWidget(timeLabel, /*stretch*/ 0);
 
+    glStatsLabel = new QLabel("GL : -", sidePanel);
+    glStatsLabel->setAlignment(Qt::AlignCenter);
+    glStatsLabel->setStyleSheet("color: gray; font: 9pt;");
+    sideLayout->addWidget(glStatsLabel, /*stretch*/ 0);
+
+    perfLabel = new QLabel(sidePanel);
+    perfLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+    perfLabel->setStyleSheet("color: gray; font: 8pt \"Courier New\";");
+    perfLabel->setVisible(options.perfOverlay);
+    sideLayout->addWidget(perfLabel, /*stretch*/ 0);
+
     mainLay->addWidget(sidePanel, /*stretch*/ 1);
 
 
     try {
         detector = new PalmDetector(
-            1,
-            "C:/Users/khali/dev/sd lakheeer/palm.xml"
+            FrameSource::fromSpec(options.source.toStdString()),
+            PalmDetector::kDefaultCascadePath
             );
+        detector->setProcessingScale(options.processingScale);
     } catch (const std::exception& e) {
         QMessageBox::critical(this, "Error", e.what());
         return;
     }
 
+    // Capture + détection tournent hors du thread GUI
+    pipeline = new PalmPipeline(detector);
+    pipeline->start();
 
-
+    // Le GUI se contente de relever le dernier résultat, au rythme du jeu
     timer = new QTimer(this);
     connect(timer, &QTimer::timeout, this, &MainWindow::updateFrame);
-    timer->start(33);
+    timer->start(16);
+
+    if (options.perfOverlay) {
+        perfTimer = new QTimer(this);
+        connect(perfTimer, &QTimer::timeout, this, &MainWindow::updatePerfOverlay);
+        perfTimer->start(500);
+    }
 
 
     connect(scene, &GameScene::scoreChanged,
             this, [this](int s){ scoreLabel->setText(QString("Score: %1").arg(s)); });
 
+    // Appels GL émis par frame (comptés, cf. glstats.h) : texte réécrit seulement quand le total change
+    connect(scene, &GameScene::glStatsChanged,
+            this, [this](int calls, int draws){
+                const QString text = QString("GL : %1 appels / %2 draws par frame").arg(calls).arg(draws);
+                if (glStatsLabel->text() != text)
+                    glStatsLabel->setText(text);
+            });
+
     connect(scene, &GameScene::elapsedTimeChanged,
             this, [this](float t){
                 int minutes = int(t) / 60;
@@ -88,28 +137,43 @@ MainWindow::MainWindow(QWidget* parent)
 
 MainWindow::~MainWindow() {
     if (timer) timer->stop();
+    if (perfTimer) perfTimer->stop();
+    delete pipeline;
+
+    // Threads arrêtés : plus aucun écrivain sur les anneaux
+    if (!perfDumpPath.isEmpty()) {
+        std::ofstream out(perfDumpPath.toStdString());
+        if (out)
+            perf::dump(out);
+        else
+            qWarning("Cannot write perf dump to %s", qPrintable(perfDumpPath));
+    }
     delete detector;
     delete scene;
 
 }
 
 void MainWindow::updateFrame() {
-    cv::Mat frame;
-    std::vector<cv::Point> centers;
-    if (!detector || !detector->getAnnotatedFrame(frame, centers))
+    if (!pipeline || !pipeline->fetchResult())
         return;
+    const perf::ScopedTimer timer(perf::UpdateFrame);
 
-    cv::Mat rgb;
-    cv::cvtColor(frame, rgb, cv::COLOR_BGR2RGB);
-    QImage img(rgb.data, rgb.cols, rgb.rows,
-               static_cast<int>(rgb.step),
-               QImage::Format_RGB888);
+    const PalmResult& result = pipeline->result();
+    const cv::Mat& frame = result.annotated;
+    const std::vector<cv::Point>& centers = result.centers;
+    if (frame.empty() || frame.type() != CV_8UC3)
+        return;
 
-    QImage disp = img.mirrored(true, false);
-    cameraWindow->label()->setPixmap(
-        QPixmap::fromImage(disp)
-            .scaled(cameraWindow->label()->size(),
-                    Qt::KeepAspectRatio));
+    // Réduction + miroir + BGR→RGB en une passe dans le buffer d’aperçu :
+    // coût fixé par la taille de la vue, indépendant de la résolution caméra ;
+    // la vue peint previewImage directement (pas de QPixmap par frame)
+    {
+        const perf::ScopedTimer previewTimer(perf::Preview);
+        PreviewView* preview = cameraWindow->view();
+        const QSize area = preview->imageArea();
+        renderPreview(previewScaler, frame, area.width(), area.height(), previewImage);
+        preview->setImage(&previewImage);
+    }
 
     if (!centers.empty()) {
         const auto& c = centers[0];
@@ -127,6 +191,44 @@ void MainWindow::updateFrame() {
         float z_offset = (disc > 0.0f ? qSqrt(disc) : 0.0f);
         float z_world  = 11.0f - z_offset;
 
-        scene->updateSwordPosition({ x_world, y_world, z_world });
+        scene->updateSwordPosition({ x_world, y_world, z_world }, result.latency);
+    }
+
+    // Mesures suffisantes : rapport sur stdout et fin de l’application
+    if (latencyTarget > 0 && int(latency.count()) >= latencyTarget)
+        finishLatencyProbe(true);
+}
+
+void MainWindow::finishLatencyProbe(bool complete) {
+    if (latencyTarget == 0)
+        return;   // Déjà rapporté (délai écoulé après la fin normale)
+
+    const int target = latencyTarget;
+    scene->setLatencyProbe(nullptr);
+    latencyTarget = 0;
+    latency.write(std::cout);   // Ce qui a été mesuré, même incomplet
+    std::cout.flush();
+
+    if (complete) {
+        QApplication::quit();
+        return;
+    }
+    std::cerr << "latency-probe: timed out with " << latency.count() << " of " << target
+              << " samples (no palm detected?)" << std::endl;
+    QApplication::exit(1);
+}
+
+void MainWindow::updatePerfOverlay() {
+    // Une ligne par sonde : moyenne / pire cas sur les perf::kWindow derniers échantillons
+    QString text;
+    for (int p = 0; p < perf::kProbeCount; ++p) {
+        const perf::Stats st = perf::stats(perf::Probe(p));
+        if (st.samples == 0) continue;
+        text += QString("%1 %2 / %3 ms\n")
+                    .arg(QString::fromLatin1(perf::probeName(p)), -16)
+                    .arg(st.avgMs, 6, 'f', 2)
+                    .arg(st.maxMs, 6, 'f', 2);
     }
+    text.chop(1);
+    perfLabel->setText(text.isEmpty() ? QString("perf : -") : text);
 }
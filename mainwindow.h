@@ -6,9 +6,13 @@
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QTimer>
+#include <QImage>
 #include "gamescene.h"
 #include "camera_window.h"
 #include "test_detectmultiscale.h"  // Pour la détection de la main (PalmDetector)
+#include "palmpipeline.h"           // Threads capture + détection
+#include "previewscaler.h"          // Aperçu caméra réduit
+#include "latencyprobe.h"           // Mesure main → sabre
 
 /*
  * Classe MainWindow :
@@ -18,11 +22,26 @@ class MainWindow : public QMainWindow {
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget* parent = nullptr); // Configure layout & initialisation
+    //--- Options de lancement (ligne de commande) ---
+    struct Options {
+        QString source          = "camera:1"; // cf. FrameSource::fromSpec (ex. "synthetic")
+        double  processingScale = 1.0;        // Échelle de détection (cf. PalmDetector)
+        double  simulationHz    = 60.0;       // Pas fixe de la simulation (cf. GameScene)
+        int     projectileCount = 1;          // Taille de la vague (rendu instancié)
+        bool    perfOverlay     = false;      // Chronos par étape dans le panel (cf. perfprobe.h)
+        QString perfDumpPath;                 // CSV des chronos écrit à la fermeture (vide = aucun)
+        int     latencySamples  = 0;          // > 0 : mesure main → sabre puis sortie (stdout)
+        int     latencyTimeoutSec = 60;       // Sans assez de mesures à temps : rapport partiel, code 1
+    };
+
+    explicit MainWindow(const Options& options = Options(),
+                        QWidget* parent = nullptr); // Configure layout & initialisation
     ~MainWindow();                                  // Nettoyage des ressources
 
 private slots:
-    void updateFrame();  // Slot appelé périodiquement pour récupérer et afficher la frame
+    void updateFrame();  // Slot appelé périodiquement pour relever le dernier résultat de détection
+    void updatePerfOverlay();  // Réécrit les moyennes / pires cas des chronos
+    void finishLatencyProbe(bool complete);  // Rapport sur stdout puis sortie (code 1 si incomplet)
 
 private:
     //--- Scène de jeu 3D ---
@@ -38,12 +57,23 @@ private:
     //--- Indicateurs de joueur ---
     QLabel*       scoreLabel;    // Affiche le score actuel
     QLabel*       timeLabel;     // Affiche le temps écoulé
+    QLabel*       glStatsLabel;  // Appels GL / draws de la dernière frame
+    QLabel*       perfLabel;     // Chronos par étape (masqué sans --perf)
 
     //--- Détection de paume ---
     PalmDetector* detector;      // Détecte la main via OpenCV
+    PalmPipeline* pipeline;      // Threads capture/détection autour de detector
+    QImage        previewImage;  // Aperçu RGB 320×240 réutilisé d’une frame à l’autre
+    PreviewScaler previewScaler; // Réduction + miroir + swizzle en une passe
 
     //--- Boucle de mise à jour ---
-    QTimer*       timer;         // Timer Qt (~30 FPS) pour updateFrame()
+    QTimer*       timer;         // Timer Qt (~60 FPS) qui relève les résultats du pipeline
+    QTimer*       perfTimer;     // Rafraîchit perfLabel (2 Hz)
+    QString       perfDumpPath;  // cf. Options::perfDumpPath
+
+    //--- Mesure de latence (--latency-probe) ---
+    LatencyHistogram latency;       // Rempli par GameScene::paintGL
+    int              latencyTarget = 0; // Mesures à collecter avant de quitter (0 : terminé)
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,115 @@
+#include "meshregistry.h"
+#include <QDebug>
+
+MeshRegistry& MeshRegistry::instance()
+{
+    static MeshRegistry registry;
+    return registry;
+}
+
+void MeshRegistry::initialize()
+{
+    if (m_initialized)
+        return;
+
+    initializeOpenGLFunctions();
+
+    const Projectile::Shape shapes[Projectile::kShapeCount] = {
+        Projectile::Shape::Apple,
+        Projectile::Shape::Cherry,
+        Projectile::Shape::IceCube,
+        Projectile::Shape::bannana
+    };
+    for (Projectile::Shape s : shapes) {
+        upload(m_meshes[static_cast<int>(s)],     Projectile::buildGeometry(s));
+        upload(m_halfMeshes[static_cast<int>(s)], Projectile::buildHalfGeometry(s));
+    }
+
+    m_initialized = true;
+}
+
+void MeshRegistry::destroy()
+{
+    for (auto* meshes : { &m_meshes, &m_halfMeshes })
+        for (ProjectileMesh& mesh : *meshes) {
+            mesh.vao.destroy();
+            mesh.vbo.destroy();
+            mesh.instanceVbo.destroy();
+            mesh.vertexCount      = 0;
+            mesh.instanceCapacity = 0;
+        }
+    m_initialized = false;
+}
+
+ProjectileMesh* MeshRegistry::mesh(Projectile::Shape s)
+{
+    if (!m_initialized) {
+        qWarning() << "MeshRegistry used before initialize()";
+        return nullptr;
+    }
+    return &m_meshes[static_cast<int>(s)];
+}
+
+ProjectileMesh* MeshRegistry::halfMesh(Projectile::Shape s)
+{
+    if (!m_initialized) {
+        qWarning() << "MeshRegistry used before initialize()";
+        return nullptr;
+    }
+    return &m_halfMeshes[static_cast<int>(s)];
+}
+
+void MeshRegistry::upload(ProjectileMesh& mesh, const std::vector<Projectile::Vertex>& verts)
+{
+    using Vertex = Projectile::Vertex;
+    constexpr int stride = sizeof(Vertex);
+
+    mesh.vertexCount = static_cast<int>(verts.size());
+
+    mesh.vao.create();
+    mesh.vao.bind();
+
+    mesh.vbo.create();
+    mesh.vbo.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    mesh.vbo.bind();
+    mesh.vbo.allocate(verts.data(), mesh.vertexCount * stride);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, pos)));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, normal)));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, uv)));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, color)));
+
+    // Location 11 : non activée pour les autres VAO, vaut alors 0 (texture appliquée)
+    glEnableVertexAttribArray(11);
+    glVertexAttribPointer(11, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, untextured)));
+
+    // Matrice modèle par instance : 4 colonnes vec4 sur les locations 4..7
+    constexpr int instStride = sizeof(ProjectileInstance);
+    mesh.instanceVbo.create();
+    mesh.instanceVbo.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    mesh.instanceVbo.bind();
+    for (int c = 0; c < 4; ++c) {
+        const size_t offset = offsetof(ProjectileInstance, model) + c * 4 * sizeof(float);
+        glEnableVertexAttribArray(4 + c);
+        glVertexAttribPointer(4 + c, 4, GL_FLOAT, GL_FALSE, instStride, reinterpret_cast<void*>(offset));
+        glVertexAttribDivisor(4 + c, 1);
+    }
+    // Matrice normale par instance : 3 colonnes vec3 sur les locations 8..10
+    for (int c = 0; c < 3; ++c) {
+        const size_t offset = offsetof(ProjectileInstance, normal) + c * 3 * sizeof(float);
+        glEnableVertexAttribArray(8 + c);
+        glVertexAttribPointer(8 + c, 3, GL_FLOAT, GL_FALSE, instStride, reinterpret_cast<void*>(offset));
+        glVertexAttribDivisor(8 + c, 1);
+    }
+
+    mesh.vao.release();
+    mesh.instanceVbo.release();
+    mesh.vbo.release();
+}
@@ -0,0 +1,64 @@
+#ifndef MESHREGISTRY_H
+#define MESHREGISTRY_H
+
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <array>
+#include "projectile.h"
+
+/*
+ * Données par instance pour le rendu instancié (divisor 1) :
+ * → model  : attributs 4..7 (une colonne vec4 par location)
+ * → normal : attributs 8..10, matrice normale calculée côté CPU une fois par
+ *   instance (le vertex shader n’inverse plus la matrice modèle à chaque sommet)
+ */
+struct ProjectileInstance {
+    float model[16];   // Matrice modèle (column-major, cf. QMatrix4x4::constData)
+    float normal[9];   // transpose(inverse(mat3(model))), column-major (cf. QMatrix3x3)
+};
+
+/*
+ * Mesh GPU d’une forme de projectile :
+ * → VBO immuable + VAO configuré, partagé par tous les projectiles de la forme.
+ * → instanceVbo : buffer par frame rempli par GameScene (une draw par forme).
+ */
+struct ProjectileMesh {
+    QOpenGLVertexArrayObject vao;
+    QOpenGLBuffer            vbo{QOpenGLBuffer::VertexBuffer};
+    QOpenGLBuffer            instanceVbo{QOpenGLBuffer::VertexBuffer};
+    int                      vertexCount      = 0;
+    int                      instanceCapacity = 0;   // Taille allouée (octets)
+};
+
+/*
+ * Classe MeshRegistry :
+ * → Registre global des meshes de projectiles, indexé par Projectile::Shape.
+ * → Chaque forme est construite et uploadée une seule fois (GameScene::initializeGL),
+ *   les projectiles ne gardent qu’un handle vers le mesh.
+ */
+class MeshRegistry : protected QOpenGLFunctions_3_3_Core
+{
+public:
+    static MeshRegistry& instance();          // Registre unique du process
+
+    void initialize();                        // Construit les 4 formes + leurs moitiés (contexte GL courant)
+    void destroy();                           // Libère VAO/VBO (contexte GL courant)
+    bool isInitialized() const { return m_initialized; }
+
+    ProjectileMesh* mesh(Projectile::Shape s); // nullptr si registre non initialisé
+    ProjectileMesh* halfMesh(Projectile::Shape s); // Demi-mesh coupé (fragments)
+
+private:
+    MeshRegistry() = default;
+    MeshRegistry(const MeshRegistry&)            = delete;
+    MeshRegistry& operator=(const MeshRegistry&) = delete;
+
+    void upload(ProjectileMesh& mesh, const std::vector<Projectile::Vertex>& verts);
+
+    std::array<ProjectileMesh, Projectile::kShapeCount> m_meshes;
+    std::array<ProjectileMesh, Projectile::kShapeCount> m_halfMeshes;
+    bool m_initialized = false;
+};
+
+#endif // MESHREGISTRY_H
@@ -0,0 +1,88 @@
+#include "palmpipeline.h"
+#include "tracer.h"
+
+PalmPipeline::PalmPipeline(PalmDetector* detector)
+    : m_detector(detector)
+{
+}
+
+PalmPipeline::~PalmPipeline()
+{
+    stop();
+}
+
+void PalmPipeline::start()
+{
+    if (m_running || !m_detector)
+        return;
+
+    m_running = true;
+    m_captureThread = QThread::create([this]() { captureLoop(); });
+    m_detectThread  = QThread::create([this]() { detectLoop(); });
+    m_captureThread->start();
+    m_detectThread->start();
+}
+
+void PalmPipeline::stop()
+{
+    m_running = false;
+    for (QThread* t : { m_captureThread, m_detectThread }) {
+        if (!t) continue;
+        t->wait();
+        delete t;
+    }
+    m_captureThread = nullptr;
+    m_detectThread  = nullptr;
+}
+
+bool PalmPipeline::fetchResult()
+{
+    return m_results.fetch();
+}
+
+void PalmPipeline::captureLoop()
+{
+    trace::setThreadName("capture");
+    while (m_running.load(std::memory_order_relaxed)) {
+        CapturedFrame& slot = m_frames.back();
+        if (!m_detector->grabFrame(slot.frame)) {
+            QThread::msleep(5);
+            continue;
+        }
+        slot.seq    = ++m_seq;
+        slot.grabNs = latencyNow();
+
+        // Détection en retard : la frame précédente non lue est remplacée par
+        // celle-ci, la détection repart toujours de la capture la plus récente.
+        if (m_frames.publish())
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PalmPipeline::detectLoop()
+{
+    trace::setThreadName("detection");
+    while (m_running.load(std::memory_order_relaxed)) {
+        if (!m_frames.fetch()) {
+            QThread::msleep(1);
+            continue;
+        }
+        CapturedFrame* slot = &m_frames.front();
+
+        PalmResult& out = m_results.back();
+        {
+            const AllocScope allocs;
+            out.centers.clear();
+            m_detector->detect(slot->frame, out.centers);
+            out.allocations = allocs.count();
+        }
+        // Dessin hors mesure : rectangle / circle allouent leurs polylignes
+        m_detector->drawAnnotations(slot->frame);
+        slot->frame.copyTo(out.annotated);
+        out.mode        = m_detector->lastMode();
+        out.seq         = slot->seq;
+        out.latency     = { slot->grabNs, latencyNow(), 0 };
+
+        m_results.publish();
+    }
+}
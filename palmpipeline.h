@@ -0,0 +1,71 @@
+#ifndef PALMPIPELINE_H
+#define PALMPIPELINE_H
+
+#include <QThread>
+#include <atomic>
+#include <vector>
+#include <opencv2/core.hpp>
+#include "latestvalue.h"
+#include "test_detectmultiscale.h"
+#include "alloccounter.h"
+#include "latencyprobe.h"
+
+/*
+ * Frame brute publiée par le thread de capture.
+ */
+struct CapturedFrame {
+    cv::Mat frame;     // BGR, buffer réutilisé (triple buffering)
+    quint64 seq = 0;   // Numéro de frame
+    std::int64_t grabNs = 0;   // Fin de lecture (cf. latencyNow)
+};
+
+/*
+ * Dernier résultat de détection publié pour le thread GUI.
+ */
+struct PalmResult {
+    cv::Mat                annotated;  // Frame annotée (preview)
+    std::vector<cv::Point> centers;    // Centres détectés (coord. pixel)
+    DetectionMode          mode = DetectionMode::FullFrame; // ROI ou plein cadre
+    quint64                seq = 0;    // Frame d’origine
+    quint64                allocations = 0; // Allocations tas de detect(), dessin exclu (cf. alloccounter.h)
+    LatencyStamp           latency;    // grab et publication ; swordNs rempli côté GUI
+};
+
+/*
+ * Classe PalmPipeline :
+ * → Thread de capture : lit la caméra et publie chaque frame dans une boîte aux lettres
+ *   "dernière valeur" ; une frame pas encore prise par la détection est écrasée.
+ * → Thread de détection : prend toujours la dernière frame capturée, lance
+ *   PalmDetector::detect et publie le résultat dans une seconde boîte aux lettres.
+ * → Le thread GUI ne fait que fetchResult() : il n’attend jamais la caméra.
+ */
+class PalmPipeline
+{
+public:
+    explicit PalmPipeline(PalmDetector* detector);  // detector non possédé
+    ~PalmPipeline();                                // stop() implicite
+
+    void start();                  // Lance les deux threads
+    void stop();                   // Arrête et joint les threads
+
+    //=== Côté GUI ===============================================================
+    bool fetchResult();                                 // true si nouveau résultat
+    const PalmResult& result() const { return m_results.front(); }
+
+    quint64 droppedFrames() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    void captureLoop();            // Corps du thread de capture
+    void detectLoop();             // Corps du thread de détection
+
+    PalmDetector*                        m_detector;
+    LatestValue<CapturedFrame>           m_frames;
+    LatestValue<PalmResult>              m_results;
+    std::atomic<bool>                    m_running{false};
+    std::atomic<quint64>                 m_dropped{0};
+    quint64                              m_seq = 0;
+    QThread*                             m_captureThread = nullptr;
+    QThread*                             m_detectThread  = nullptr;
+};
+
+#endif // PALMPIPELINE_H
@@ -0,0 +1,206 @@
+#include "particlesystem.h"
+#include "sceneuniforms.h"
+#include <QOpenGLShaderProgram>
+#include <QRandomGenerator>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+//=== Shaders ==================================================================
+// aSeed    : vitesse initiale (xyz) + facteur de taille (w), une entrée par particule
+// iEmitter : origine (xyz) + naissance (w), une entrée par émetteur (divisor 1)
+static const char* vParticleSrc = R"(#version 330 core
+layout(location = 0) in vec4 aSeed;
+layout(location = 1) in vec4 iEmitter;
+
+// Doit correspondre à SceneBlock (sceneuniforms.h)
+layout(std140) uniform SceneBlock {
+    mat4 uView;
+    mat4 uProj;
+    vec4 uLightDir;
+    vec4 uViewPos;
+};
+
+uniform float uTime;
+uniform float uLifetime;
+uniform float uGravity;
+uniform float uPointScale;
+
+out float vFade;
+
+void main() {
+    float age = uTime - iEmitter.w;
+    if (age < 0.0 || age > uLifetime) {
+        // Émetteur éteint : hors du volume de clipping, rien n’est rasterisé
+        gl_Position  = vec4(2.0, 2.0, 2.0, 1.0);
+        gl_PointSize = 1.0;
+        vFade        = 0.0;
+        return;
+    }
+    vec3 p = iEmitter.xyz + aSeed.xyz * age - vec3(0.0, 0.5 * uGravity * age * age, 0.0);
+    vec4 viewPos = uView * vec4(p, 1.0);
+    gl_Position  = uProj * viewPos;
+    gl_PointSize = uPointScale * aSeed.w / max(-viewPos.z, 0.1);
+    vFade        = 1.0 - age / uLifetime;
+})";
+
+static const char* fParticleSrc = R"(#version 330 core
+in float vFade;
+out vec4 fragColor;
+
+void main() {
+    // Point rond, du jaune vers le rouge en fin de vie
+    vec2  d = gl_PointCoord - vec2(0.5);
+    float r = dot(d, d);
+    if (r > 0.25) discard;
+    vec3 color = mix(vec3(1.0, 0.2, 0.0), vec3(1.0, 0.8, 0.0), vFade);
+    fragColor  = vec4(color, vFade * (1.0 - 4.0 * r));
+})";
+
+//=== Cycle de vie GL ==========================================================
+void ParticleSystem::initialize(SceneUniforms& scene)
+{
+    initializeOpenGLFunctions();
+
+    m_program = new QOpenGLShaderProgram();
+    if (!m_program->addShaderFromSourceCode(QOpenGLShader::Vertex,   vParticleSrc) ||
+        !m_program->addShaderFromSourceCode(QOpenGLShader::Fragment, fParticleSrc) ||
+        !m_program->link()) {
+        qWarning() << "ParticleSystem: shader error" << m_program->log();
+        delete m_program;
+        m_program = nullptr;
+        return;
+    }
+    scene.attach(*m_program);
+    m_locTime = m_program->uniformLocation("uTime");
+
+    m_program->bind();
+    m_program->setUniformValue("uLifetime",   kLifetime);
+    m_program->setUniformValue("uGravity",    9.8f);
+    m_program->setUniformValue("uPointScale", 60.f);
+    m_program->release();
+
+    // Table de vitesses tirée une fois : direction uniforme sur la sphère, 1 à 4 m/s
+    std::vector<float> seeds;
+    seeds.reserve(kParticlesPerEmitter * 4);
+    QRandomGenerator* rng = QRandomGenerator::global();
+    for (int i = 0; i < kParticlesPerEmitter; ++i) {
+        const float z     = float(rng->generateDouble() * 2.0 - 1.0);
+        const float phi   = float(rng->generateDouble() * 2.0 * M_PI);
+        const float rxy   = std::sqrt(1.f - z * z);
+        const float speed = 1.f + 3.f * float(rng->generateDouble());
+        seeds.push_back(rxy * std::cos(phi) * speed);
+        seeds.push_back(rxy * std::sin(phi) * speed);
+        seeds.push_back(z * speed);
+        seeds.push_back(0.5f + float(rng->generateDouble()));
+    }
+
+    // Liste d’émetteurs vide, VBO à capacité pleine
+    m_emitters.assign(kMaxEmitters, Emitter{ 0.f, 0.f, 0.f, -1e9f });
+    m_count     = 0;
+    m_evictions = 0;
+    m_dirty     = false;
+
+    m_vao.create();
+    m_vao.bind();
+
+    m_seedVbo.create();
+    m_seedVbo.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    m_seedVbo.bind();
+    m_seedVbo.allocate(seeds.data(), int(seeds.size() * sizeof(float)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
+    m_seedVbo.release();
+
+    m_emitterVbo.create();
+    m_emitterVbo.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    m_emitterVbo.bind();
+    m_emitterVbo.allocate(m_emitters.data(), int(m_emitters.size() * sizeof(Emitter)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Emitter), nullptr);
+    glVertexAttribDivisor(1, 1);
+    m_emitterVbo.release();
+
+    m_vao.release();
+}
+
+void ParticleSystem::destroy()
+{
+    m_vao.destroy();
+    m_seedVbo.destroy();
+    m_emitterVbo.destroy();
+    delete m_program;
+    m_program = nullptr;
+}
+
+//=== Émetteurs ================================================================
+void ParticleSystem::spawn(const QVector3D& pos, float time)
+{
+    if (m_emitters.empty())
+        return;
+
+    // Naissances décroissantes : les explosions finies sont en queue, élaguées d’abord
+    while (m_count > 0 && time - m_emitters[m_count - 1].birth > kLifetime)
+        --m_count;
+    // Encore pleine : le plus ancien est coupé alors qu’il est visible
+    if (m_count == kMaxEmitters) {
+        --m_count;
+        ++m_evictions;
+    }
+
+    // Appelé depuis la simulation (hors contexte GL) : l’upload est fait au rendu
+    std::copy_backward(m_emitters.begin(), m_emitters.begin() + m_count,
+                       m_emitters.begin() + m_count + 1);
+    m_emitters[0] = { pos.x(), pos.y(), pos.z(), time };
+    ++m_count;
+    m_dirty = true;
+}
+
+void ParticleSystem::clear()
+{
+    if (m_emitters.empty())
+        return;
+
+    m_count = 0;
+    m_dirty = false;   // Rien à dessiner : le prochain spawn ré-uploadera
+}
+
+//=== Rendu ====================================================================
+void ParticleSystem::render(float time)
+{
+    if (!m_program)
+        return;
+
+    // Vivants en tête : on compte jusqu’au premier éteint, aucune draw s’il n’y en a pas
+    int live = 0;
+    while (live < m_count && time - m_emitters[live].birth <= kLifetime)
+        ++live;
+    if (live == 0)
+        return;
+
+    // Liste modifiée depuis la dernière frame : un seul upload, émetteurs en tête seulement
+    if (m_dirty) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_emitterVbo.bufferId());
+        glBufferSubData(GL_ARRAY_BUFFER, 0, GLsizeiptr(m_count * sizeof(Emitter)), m_emitters.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        m_dirty = false;
+    }
+
+    glUseProgram(m_program->programId());
+    glUniform1f(m_locTime, time);
+
+    // Additif, test de profondeur sans écriture : l’ordre des points est indifférent
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+
+    glBindVertexArray(m_vao.objectId());
+    glDrawArraysInstanced(GL_POINTS, 0, kParticlesPerEmitter, live);
+    glBindVertexArray(0);
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glUseProgram(0);
+}
@@ -0,0 +1,66 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include "glstats.h"
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QVector3D>
+#include <vector>
+
+class QOpenGLShaderProgram;
+class SceneUniforms;
+
+/*
+ * Classe ParticleSystem :
+ * → Explosions d’impact entièrement animées sur le GPU : le CPU n’écrit que
+ *   l’émetteur (origine + instant de naissance) au moment du coup.
+ * → Les émetteurs sont rangés du plus récent au plus ancien dans un VBO de capacité
+ *   fixe : les vivants en forment toujours le début, et la draw ne couvre qu’eux (le
+ *   vertex shader ne tourne pas sur les explosions finies). La liste est ré-uploadée
+ *   (4 Ko au plus) dans la frame qui suit un coup ; les vitesses des particules sont
+ *   une table statique partagée.
+ * → Liste pleine : le plus ancien est évincé même s’il est encore visible, et compté
+ *   dans evictions(). La capacité couvre kMaxEmitters coups par kLifetime.
+ * → Le vertex shader calcule âge, trajectoire balistique et fondu : toutes les
+ *   explosions en vol coûtent une seule draw instanciée (points, divisor 1).
+ */
+class ParticleSystem : protected glstats::CountingFunctions
+{
+public:
+    static constexpr int   kMaxEmitters         = 256;   // Explosions simultanées max
+    static constexpr int   kParticlesPerEmitter = 256;   // Points par explosion
+    static constexpr float kLifetime            = 0.8f;  // Durée de vie (s)
+
+    ParticleSystem() = default;
+
+    void initialize(SceneUniforms& scene); // Shader relié à l’UBO de scène + buffers (contexte GL courant)
+    void destroy();                       // Libère les ressources GL (contexte GL courant)
+
+    // Côté CPU uniquement (appelables hors contexte GL), uploadés au prochain render()
+    void spawn(const QVector3D& pos, float time); // Nouvel émetteur né à time (s)
+    void clear();                                 // Éteint tous les émetteurs
+
+    // Explosions encore visibles évincées par un nouveau coup (liste pleine)
+    int evictions() const { return m_evictions; }
+
+    // Une draw pour tous les émetteurs vivants (aucune si tout est éteint)
+    void render(float time);              // Vue/proj lues dans l’UBO de scène
+
+private:
+    struct Emitter {
+        float x, y, z;      // Origine
+        float birth;        // Instant de naissance (s)
+    };
+
+    QOpenGLShaderProgram*    m_program = nullptr;
+    QOpenGLVertexArrayObject m_vao;
+    QOpenGLBuffer            m_seedVbo{QOpenGLBuffer::VertexBuffer};     // Vitesse + taille par particule
+    QOpenGLBuffer            m_emitterVbo{QOpenGLBuffer::VertexBuffer};  // Émetteurs, plus récent en tête
+    std::vector<Emitter>     m_emitters;         // Copie CPU, naissances décroissantes
+    int                      m_count     = 0;    // Émetteurs en tête (vivants ou pas encore élagués)
+    int                      m_evictions = 0;    // cf. evictions()
+    bool                     m_dirty     = false; // Liste CPU à ré-uploader
+    int                      m_locTime   = -1;
+};
+
+#endif // PARTICLESYSTEM_H
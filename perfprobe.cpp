@@ -0,0 +1,85 @@
+#include "perfprobe.h"
+#include <algorithm>
+
+namespace perf {
+
+namespace {
+
+// Anneau d’une sonde : durées en µs entières (32 bits, > 1 h), index d’écriture monotone
+struct Ring {
+    std::atomic<std::uint32_t> us[kWindow] = {};
+    std::atomic<std::uint32_t> head{0};
+};
+
+Ring s_rings[kProbeCount];
+
+} // namespace
+
+const char* probeName(int probe)
+{
+    static const char* const names[kProbeCount] = {
+        "capture", "detect_segment", "detect_contours", "detect_cascade",
+        "detect_fallback", "detect", "update_frame", "preview", "sword_update",
+        "tick", "paint"
+    };
+    return (probe >= 0 && probe < kProbeCount) ? names[probe] : "?";
+}
+
+void setEnabled(bool on)
+{
+    enabledFlag().store(on, std::memory_order_relaxed);
+}
+
+void record(Probe probe, std::uint64_t ns)
+{
+    Ring& ring = s_rings[probe];
+    const std::uint32_t head = ring.head.load(std::memory_order_relaxed);
+    const std::uint64_t us   = std::min<std::uint64_t>(ns / 1000, UINT32_MAX);
+    ring.us[head % kWindow].store(std::uint32_t(us), std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+Stats stats(Probe probe)
+{
+    const Ring& ring = s_rings[probe];
+    const std::uint32_t head = ring.head.load(std::memory_order_acquire);
+    const int n = int(std::min<std::uint32_t>(head, kWindow));
+
+    Stats s;
+    if (n == 0) return s;
+    std::uint64_t total = 0, worst = 0;
+    for (int i = 0; i < n; ++i) {
+        const std::uint32_t us = ring.us[i].load(std::memory_order_relaxed);
+        total += us;
+        worst  = std::max<std::uint64_t>(worst, us);
+    }
+    s.avgMs   = total * 1e-3 / n;
+    s.maxMs   = worst * 1e-3;
+    s.samples = n;
+    return s;
+}
+
+void clear()
+{
+    for (Ring& ring : s_rings) {
+        for (auto& us : ring.us) us.store(0, std::memory_order_relaxed);
+        ring.head.store(0, std::memory_order_release);
+    }
+}
+
+void dump(std::ostream& out)
+{
+    out << "probe,sample,ms\n";
+    for (int p = 0; p < kProbeCount; ++p) {
+        const Ring& ring = s_rings[p];
+        const std::uint32_t head = ring.head.load(std::memory_order_acquire);
+        const std::uint32_t n    = std::min<std::uint32_t>(head, kWindow);
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const std::uint32_t index = head - n + i;
+            out << probeName(p) << ',' << index << ','
+                << ring.us[index % kWindow].load(std::memory_order_relaxed) * 1e-3 << '\n';
+        }
+    }
+}
+
+} // namespace perf
@@ -0,0 +1,94 @@
+#ifndef PERFPROBE_H
+#define PERFPROBE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include "tracer.h"
+
+/*
+ * Chronos du chemin critique d’une frame (capture, détection, GUI, tick, rendu) :
+ * → Un anneau de kWindow durées par sonde, lock-free : un seul thread écrit une sonde
+ *   donnée (le sien), le thread GUI lit moyennes et pires cas sans jamais le bloquer.
+ * → Désactivé par défaut : un ScopedTimer ne coûte alors qu’un load atomique relâché,
+ *   aucune lecture d’horloge.
+ * → dump() écrit les échantillons retenus en CSV (probe,sample,ms).
+ * → Si le traceur est actif (tracer.h), chaque portée devient aussi un événement Chrome.
+ */
+namespace perf {
+
+enum Probe {
+    Capture,         // PalmDetector::grabFrame (thread de capture)
+    DetectSegment,   // detect() : peau + morphologie
+    DetectContours,  // detect() : heuristique contours (+ affinage pleine rés.)
+    DetectCascade,   // detect() : attente / fusion du fallback cascade
+    DetectFallback,  // detect() : distanceTransform de repli
+    Detect,          // detect() complet
+    UpdateFrame,     // MainWindow::updateFrame (thread GUI)
+    Preview,         // Aperçu caméra (réduction dans la QImage peinte par PreviewView)
+    SwordUpdate,     // GameScene::updateSwordPosition
+    Tick,            // GameScene::tick
+    Paint,           // GameScene::paintGL (soumission CPU)
+    kProbeCount
+};
+
+constexpr int kWindow = 128;     // Échantillons retenus par sonde
+
+const char* probeName(int probe);
+
+void setEnabled(bool on);
+inline std::atomic<bool>& enabledFlag()
+{
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+inline bool enabled() { return enabledFlag().load(std::memory_order_relaxed); }
+
+void record(Probe probe, std::uint64_t ns);  // Thread propriétaire de la sonde uniquement
+
+struct Stats {
+    double avgMs   = 0.0;   // Moyenne glissante sur la fenêtre
+    double maxMs   = 0.0;   // Pire cas sur la fenêtre
+    int    samples = 0;
+};
+Stats stats(Probe probe);   // Lecture concurrente : approximative, jamais bloquante
+
+void clear();                       // Vide toutes les fenêtres
+void dump(std::ostream& out);       // CSV probe,sample,ms (du plus ancien au plus récent)
+
+/*
+ * Classe ScopedTimer : chronomètre la portée courante, l’enregistre dans probe
+ * et/ou la trace.
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Probe probe)
+        : m_probe(probe), m_active(enabled() || trace::enabled())
+    {
+        if (m_active) m_start = std::chrono::steady_clock::now();
+    }
+    ~ScopedTimer()
+    {
+        if (!m_active) return;
+        const auto end = std::chrono::steady_clock::now();
+        if (enabled())
+            record(m_probe, std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                end - m_start).count()));
+        if (trace::enabled())
+            trace::complete(probeName(m_probe), m_start, end);
+    }
+
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Probe                                 m_probe;
+    bool                                  m_active;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace perf
+
+#endif // PERFPROBE_H
@@ -0,0 +1,25 @@
+#ifndef PREVIEWIMAGE_H
+#define PREVIEWIMAGE_H
+
+#include <QImage>
+#include <opencv2/core.hpp>
+#include "previewscaler.h"
+
+/*
+ * Aperçu caméra du thread GUI (MainWindow::updateFrame, tests/test_allocations) :
+ * → frame BGR réduite + miroir + RGB en une passe dans image ;
+ * → image réutilisée tant que la taille tenant dans maxW×maxH ne change pas
+ *   (aucune allocation en régime établi).
+ */
+inline void renderPreview(PreviewScaler& scaler, const cv::Mat& frame,
+                          int maxW, int maxH, QImage& image)
+{
+    int w = 0, h = 0;
+    PreviewScaler::fitSize(frame.cols, frame.rows, maxW, maxH, w, h);
+    if (image.width() != w || image.height() != h)
+        image = QImage(w, h, QImage::Format_RGB888);
+    scaler.run(frame.data, frame.step, frame.cols, frame.rows,
+               image.bits(), image.bytesPerLine(), w, h);
+}
+
+#endif // PREVIEWIMAGE_H
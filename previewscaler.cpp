@@ -0,0 +1,63 @@
+#include "previewscaler.h"
+#include <algorithm>
+
+void PreviewScaler::fitSize(int srcW, int srcH, int maxW, int maxH, int& outW, int& outH)
+{
+    if (srcW <= 0 || srcH <= 0) { outW = outH = 0; return; }
+    // Comparaison en entiers : srcW/srcH >= maxW/maxH ⇒ la largeur limite
+    if (std::int64_t(srcW) * maxH >= std::int64_t(srcH) * maxW) {
+        outW = maxW;
+        outH = std::max(1, int(std::int64_t(srcH) * maxW / srcW));
+    } else {
+        outH = maxH;
+        outW = std::max(1, int(std::int64_t(srcW) * maxH / srcH));
+    }
+}
+
+void PreviewScaler::buildTables(int srcW, int srcH, int dstW, int dstH)
+{
+    m_srcW = srcW; m_srcH = srcH; m_dstW = dstW; m_dstH = dstH;
+
+    m_col0.resize(dstW);
+    m_col1.resize(dstW);
+    for (int x = 0; x < dstW; ++x) {
+        // Colonne de sortie x ↔ colonne miroir dstW-1-x de l’image non retournée
+        const int c0 = int(std::int64_t(dstW - 1 - x) * srcW / dstW);
+        const int c1 = std::min(c0 + 1, srcW - 1);
+        m_col0[x] = c0 * 3;
+        m_col1[x] = c1 * 3;
+    }
+
+    m_row0.resize(dstH);
+    m_row1.resize(dstH);
+    for (int y = 0; y < dstH; ++y) {
+        const int r0 = int(std::int64_t(y) * srcH / dstH);
+        m_row0[y] = r0;
+        m_row1[y] = std::min(r0 + 1, srcH - 1);
+    }
+}
+
+void PreviewScaler::run(const std::uint8_t* bgr, std::size_t bgrStep, int srcW, int srcH,
+                        std::uint8_t* rgb, std::size_t rgbStep, int dstW, int dstH)
+{
+    if (srcW <= 0 || srcH <= 0 || dstW <= 0 || dstH <= 0)
+        return;
+    if (srcW != m_srcW || srcH != m_srcH || dstW != m_dstW || dstH != m_dstH)
+        buildTables(srcW, srcH, dstW, dstH);
+
+    const int* col0 = m_col0.data();
+    const int* col1 = m_col1.data();
+    for (int y = 0; y < dstH; ++y) {
+        const std::uint8_t* a = bgr + std::size_t(m_row0[y]) * bgrStep;
+        const std::uint8_t* b = bgr + std::size_t(m_row1[y]) * bgrStep;
+        std::uint8_t*       d = rgb + std::size_t(y) * rgbStep;
+
+        for (int x = 0; x < dstW; ++x, d += 3) {
+            const int i = col0[x], j = col1[x];
+            // Moyenne 2×2 arrondie, canaux permutés B,G,R → R,G,B
+            d[0] = std::uint8_t((a[i+2] + a[j+2] + b[i+2] + b[j+2] + 2) >> 2);
+            d[1] = std::uint8_t((a[i+1] + a[j+1] + b[i+1] + b[j+1] + 2) >> 2);
+            d[2] = std::uint8_t((a[i  ] + a[j  ] + b[i  ] + b[j  ] + 2) >> 2);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef PREVIEWSCALER_H
+#define PREVIEWSCALER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Classe PreviewScaler :
+ * → Réduction + miroir horizontal + BGR → RGB en une seule passe, directement dans
+ *   le buffer de l’aperçu (320×240) : le coût ne dépend que de la taille de sortie.
+ * → Chaque pixel de sortie moyenne un bloc 2×2 de la source (les traits d’annotation
+ *   d’un pixel restent visibles), tables d’indices recalculées seulement si les
+ *   dimensions changent.
+ * → Les pas (step) sont en octets, comme pour skin::segmentBgr.
+ */
+class PreviewScaler
+{
+public:
+    // Plus grande taille de sortie tenant dans maxW×maxH en gardant le ratio source
+    static void fitSize(int srcW, int srcH, int maxW, int maxH, int& outW, int& outH);
+
+    void run(const std::uint8_t* bgr, std::size_t bgrStep, int srcW, int srcH,
+             std::uint8_t* rgb, std::size_t rgbStep, int dstW, int dstH);
+
+private:
+    void buildTables(int srcW, int srcH, int dstW, int dstH);
+
+    int m_srcW = 0, m_srcH = 0, m_dstW = 0, m_dstH = 0;
+    std::vector<int> m_col0, m_col1;   // Décalages octets des deux colonnes (miroir)
+    std::vector<int> m_row0, m_row1;   // Indices des deux lignes sources
+};
+
+#endif // PREVIEWSCALER_H
@@ -1,50 +1,5 @@
 #include "Projectile.h"
-#include <QOpenGLShaderProgram>
 #include <cmath>
-#include <QDebug>
-#include <QVector3D>
-struct Vertex { QVector3D pos; QVector3D normal; QVector2D uv; QVector3D color; };
-
-
-#include <QFile>
-#include <QOpenGLTexture>
-#include <QImage>
-#include <QDebug>
-
-
-
-Projectile::Projectile(const Settings& cfg)
-    : m_cfg(cfg)
-    , m_shape(cfg.shape)
-    , m_vel(cfg.velocity)
-    , m_size(cfg.size)
-    , m_initialPosition(cfg.initialPosition)
-    , m_targetPoint(cfg.targetPoint)
-    , m_isFragment(cfg.isFragment)
-    , m_active(true)
-    , m_visible(true)
-    , m_time(0.f)
-{
-
-    initializeOpenGLFunctions();
-
-
-    loadShapeTexture();
-
-
-    buildGeometry();
-    uploadGeometry();
-
-
-    m_pos = m_initialPosition;
-}
-
-
-Projectile::~Projectile()
-{
-    m_vao.destroy();
-    m_vbo.destroy();
-}
 
 const QVector3D Projectile::kAxes[4] = {
     QVector3D(1, 0, 0),
@@ -52,85 +7,7 @@ const QVector3D Projectile::kAxes[4] = {
     QVector3D(0, 0, 1),
     QVector3D(1, 1, 0).normalized()
 };
-static QString textureForShape(Projectile::Shape s) {
-    switch (s) {
-    case Projectile::Shape::Apple:   return "C:/Users/khali/dev/sd lakheeer/assets/apple.jpg";
-    case Projectile::Shape::bannana: return "C:/Users/khali/dev/sd lakheeer/assets/banana.jpg";
-    case Projectile::Shape::Cherry:  return "C:/Users/khali/dev/sd lakheeer/assets/cherry.jpg";
-    case Projectile::Shape::IceCube: return "C:/Users/khali/dev/sd lakheeer/assets/ice.jpg";
-    }
-    return "";
-}
-void Projectile::loadShapeTexture() {
-    m_texture.reset();
-    QString path = textureForShape(m_shape);
-    if (QFile::exists(path)) {
-        QImage img(path);
-        img = img.mirrored();
-        m_texture.reset(new QOpenGLTexture(img));
-        m_texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
-        m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-        m_texture->setWrapMode(QOpenGLTexture::Repeat);
-    } else {
-        qWarning() << "Missing projectile texture:" << path;
-    }
-}
-void Projectile::setShape(Shape s)
-{
-    m_shape = s;
 
-    loadShapeTexture();
-    buildGeometry();
-    uploadGeometry();
-}
-
-
-static float randomX(float minX, float maxX)
-{
-    double zeroToOne = QRandomGenerator::global()->generateDouble();
-    return minX + static_cast<float>(zeroToOne * (maxX - minX));
-}
-
-
-void Projectile::update(float dt)
-{
-    if (!m_active) return;
-
-    const QVector3D gravity(0.f, -9.81f, 0.f);
-    m_vel += gravity * dt;
-    m_pos += m_vel * dt;
-
-    if (m_pos.z() < -5.f) m_active = false;
-}
-
-void Projectile::computeProjectilePositionAtTime(
-    QVector3D initialPoint,
-    QVector3D targetPoint,
-    float alphaDeg,
-    float t,
-    float g )
-{
-    float alpha = qDegreesToRadians(alphaDeg);
-
-    float dx = targetPoint.x() - initialPoint.x();
-    float dz = targetPoint.z() - initialPoint.z();
-    float dy = targetPoint.y() - initialPoint.y();
-
-    float d = std::sqrt(dx * dx + dz * dz);
-
-    float V0 = (d / std::cos(alpha)) * std::sqrt(g / (2 * (d * std::tan(alpha) - dy)));
-
-    QVector3D dirXZ(dx, 0, dz);
-    dirXZ.normalize();
-
-    QVector3D velocity = V0 * (dirXZ * std::cos(alpha) + QVector3D(0, std::sin(alpha), 0));
-
-    QVector3D acceleration(0, -g, 0);
-
-    QVector3D position = initialPoint + velocity * t + 0.5f * acceleration * t * t;
-
-    m_pos= position;
-}
 static int randomInt(int min, int max)
 {
     return QRandomGenerator::global()->bounded(min, max + 1);
@@ -148,117 +25,8 @@ Projectile::Shape  Projectile::RandomShape()
     return tab[index];
 }
 
-void Projectile::reset(const QVector3D& start, const QVector3D& target)
+std::vector<Projectile::Vertex> Projectile::buildGeometryApple()
 {
-    m_initialPosition = start;
-    m_targetPoint     = target;
-    m_pos             = start;
-    m_time            = 0.f;
-    m_active          = true;
-    m_visible         = true;
-
-    m_axisIndex = (m_axisIndex + 1) % 4;
-    m_rotAxis   = kAxes[m_axisIndex];
-
-    buildGeometry();
-    uploadGeometry();
-    loadShapeTexture();
-}
-
-void Projectile::advanceTime(float dt)
-{
-    if (!m_active) return;
-    m_time += dt;
-    m_rotAngle += m_rotSpeed * m_timeStep;
-    buildGeometry();
-    uploadGeometry();
-    m_rotAngle += m_rotSpeed * dt;
-    if (m_rotAngle >= 360.f) m_rotAngle -= 360.f;
-    computeProjectilePositionAtTime(
-        m_initialPosition,
-        m_targetPoint,
-        40.f,
-        m_time,
-        9.8f
-        );
-
-    if (m_pos.z() >= m_targetPoint.z() ) {
-        m_active = false;
-
-    }
-}
-
-
-
-
-void Projectile::render(QOpenGLShaderProgram& shader,
-                        const QMatrix4x4& view,
-                        const QMatrix4x4& proj)
-{
-    if (!m_active || !m_visible)
-        return;
-
-    m_rotAngle += m_rotSpeed * m_timeStep;
-    if (m_rotAngle >= 360.f)
-        m_rotAngle -= 360.f;
-
-    shader.bind();
-    QMatrix4x4 model;
-    model.translate(m_pos);
-    model.rotate(m_rotAngle, m_rotAxis);
-    model.scale(m_size);
-    shader.setUniformValue("uModel", model);
-    shader.setUniformValue("uView",  view);
-    shader.setUniformValue("uProj",  proj);
-
-    if (m_texture) {
-        qDebug()<<"texture shi";
-        shader.setUniformValue("uHasTex", 1);
-        shader.setUniformValue("uTexture", 0);
-        glActiveTexture(GL_TEXTURE0);
-        m_texture->bind();
-    } else {
-        shader.setUniformValue("uHasTex", 0);
-    }
-
-    m_vao.bind();
-    glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
-    m_vao.release();
-
-    if (m_texture)
-        m_texture->release();
-    shader.release();
-}
-
-
-
-QVector<Projectile*> Projectile::split()
-{
-    QVector<Projectile*> fragments;
-
-    if (!m_active) return fragments;
-    m_active = false;
-
-    Settings fragSet;
-    fragSet.shape  = m_shape;
-    fragSet.size   = m_size * 0.5f;
-    fragSet.textureImg = "";
-
-    fragSet.position = m_pos + QVector3D(+0.1f, 0.f, 0.f);
-    fragSet.velocity = m_vel + QVector3D(+1.f, +2.f, 0.f);
-    fragments.append(new Projectile(fragSet));
-
-    fragSet.position = m_pos + QVector3D(-0.1f, 0.f, 0.f);
-    fragSet.velocity = m_vel + QVector3D(-1.f, +2.f, 0.f);
-    fragments.append(new Projectile(fragSet));
-
-    return fragments;
-}
-
-void Projectile::buildGeometryApple()
-{
-    struct Vertex { QVector3D pos; QVector3D normal; QVector2D uv; QVector3D color; };
-
     const QVector3D bodyColor(1.0f, 0.1f, 0.1f);
     const QVector3D leafColor(0.2f, 0.8f, 0.2f);
 
@@ -366,19 +134,13 @@ void Projectile::buildGeometryApple()
         verts.push_back({ C2,         leafNormal, leafUv3, leafColor });
     }
 
-    m_vertexCount = static_cast<int>(verts.size());
-    m_vbo.create();
-    m_vbo.bind();
-    m_vbo.allocate(verts.data(), m_vertexCount * sizeof(Vertex));
-    m_vbo.release();
+    return verts;
 }
 
 
 
-void Projectile::buildGeometryCherry()
+std::vector<Projectile::Vertex> Projectile::buildGeometryCherry()
 {
-    struct Vertex { QVector3D pos; QVector3D normal; QVector2D uv; QVector3D color; };
-
     const QVector3D cherryRed(1.0f, 0.0f, 0.0f);
     const QVector3D stemGreen(0.0f, 0.8f, 0.0f);
     const QVector3D leafColor(0.2f, 0.6f, 0.2f);
@@ -465,23 +227,13 @@ void Projectile::buildGeometryCherry()
     verts.push_back({L1, nL, luv1, leafColor});
     verts.push_back({L2, nL, luv2, leafColor});
 
-    m_vertexCount = int(verts.size());
-    m_vbo.create(); m_vbo.bind();
-    m_vbo.allocate(verts.data(), m_vertexCount * sizeof(Vertex));
-    m_vbo.release();
+    return verts;
 }
 
 
 
-void Projectile::buildGeometryBanana()
+std::vector<Projectile::Vertex> Projectile::buildGeometryBanana()
 {
-    struct Vertex {
-        QVector3D pos;
-        QVector3D normal;
-        QVector2D uv;
-        QVector3D color;
-    };
-
     const QVector3D bananaYellow(1.0f, 0.9f, 0.1f);
     constexpr int   curveSteps = 20;
     constexpr int   sliceSteps = 16;
@@ -581,18 +333,12 @@ void Projectile::buildGeometryBanana()
         }
     }
 
-    m_vertexCount = static_cast<int>(verts.size());
-    m_vbo.create();
-    m_vbo.bind();
-    m_vbo.allocate(verts.data(), m_vertexCount * sizeof(Vertex));
-    m_vbo.release();
+    return verts;
 }
 
 
-void Projectile::buildGeometryIceCube()
+std::vector<Projectile::Vertex> Projectile::buildGeometryIceCube()
 {
-    struct Vertex { QVector3D pos; QVector3D normal; QVector2D uv; QVector3D color; };
-
     const QVector3D iceColor(0.6f, 0.8f, 1.0f);
     const float h = 0.5f;
 
@@ -640,53 +386,87 @@ void Projectile::buildGeometryIceCube()
         verts.push_back({ corners[i3], n, uv[3], iceColor });
     }
 
-    m_vertexCount = static_cast<int>(verts.size());
-    m_vbo.create();
-    m_vbo.bind();
-    m_vbo.allocate(verts.data(), m_vertexCount * sizeof(Vertex));
-    m_vbo.release();
+    return verts;
 }
 
-void Projectile::buildGeometry()
+std::vector<Projectile::Vertex> Projectile::buildGeometry(Shape shape)
 {
-    switch (m_shape)
+    switch (shape)
     {
-    case Shape::Apple:     buildGeometryApple();     break;
-    case Shape::Cherry:  buildGeometryCherry();  break;
-    case Shape::bannana: buildGeometryBanana(); break;
-    case Shape::IceCube:   buildGeometryIceCube(); break;
+    case Shape::Apple:   return buildGeometryApple();
+    case Shape::Cherry:  return buildGeometryCherry();
+    case Shape::bannana: return buildGeometryBanana();
+    case Shape::IceCube: return buildGeometryIceCube();
     }
+    return {};
 }
 
-void Projectile::uploadGeometry()
+std::vector<Projectile::Vertex> Projectile::buildHalfGeometry(Shape shape)
 {
-    struct Vertex {
-        QVector3D pos;
-        QVector3D normal;
-        QVector2D uv;
-        QVector3D color;
-    };
-
-    constexpr int stride = sizeof(Vertex);
-
-    m_vao.create();
-    m_vao.bind();
-
-    m_vbo.bind();
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, pos)));
-
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, normal)));
+    // Couleur de la chair visible sur la face coupée
+    QVector3D flesh;
+    switch (shape)
+    {
+    case Shape::Apple:   flesh = { 1.0f, 0.95f, 0.8f };  break;
+    case Shape::Cherry:  flesh = { 0.7f, 0.0f,  0.1f };  break;
+    case Shape::bannana: flesh = { 1.0f, 0.97f, 0.75f }; break;
+    case Shape::IceCube: flesh = { 0.85f, 0.95f, 1.0f }; break;
+    }
 
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, uv)));
+    auto lerp = [](const Vertex& a, const Vertex& b, float t) {
+        return Vertex{ a.pos + (b.pos - a.pos) * t,
+                       (a.normal + (b.normal - a.normal) * t).normalized(),
+                       a.uv + (b.uv - a.uv) * t,
+                       a.color + (b.color - a.color) * t,
+                       a.untextured };
+    };
 
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(Vertex, color)));
+    const std::vector<Vertex> full = buildGeometry(shape);
+    std::vector<Vertex> half;
+    std::vector<QVector3D> cut;   // Segments sur le plan x = 0 (par paires)
+    half.reserve(full.size() / 2 + 64);
+
+    // Découpe de chaque triangle par le demi-espace x >= 0 (Sutherland-Hodgman)
+    for (size_t i = 0; i + 2 < full.size(); i += 3) {
+        Vertex poly[4];
+        int    count = 0;
+        for (int e = 0; e < 3; ++e) {
+            const Vertex& a = full[i + e];
+            const Vertex& b = full[i + (e + 1) % 3];
+            const bool inA = a.pos.x() >= 0.f;
+            const bool inB = b.pos.x() >= 0.f;
+            if (inA)
+                poly[count++] = a;
+            if (inA != inB) {
+                const Vertex p = lerp(a, b, a.pos.x() / (a.pos.x() - b.pos.x()));
+                poly[count++] = p;
+                cut.push_back(p.pos);
+            }
+        }
+        for (int k = 1; k + 1 < count; ++k) {
+            half.push_back(poly[0]);
+            half.push_back(poly[k]);
+            half.push_back(poly[k + 1]);
+        }
+    }
 
-    m_vbo.release();
-    m_vao.release();
+    // Face coupée : éventail depuis le centre des points de coupe, normale -x
+    if (cut.size() >= 2) {
+        QVector3D center;
+        for (const QVector3D& p : cut) center += p;
+        center /= float(cut.size());
+
+        const QVector3D n(-1.f, 0.f, 0.f);
+        const QVector2D uv(0.5f, 0.5f);
+        for (size_t k = 0; k + 1 < cut.size(); k += 2) {
+            QVector3D a = cut[k], b = cut[k + 1];
+            if (QVector3D::dotProduct(QVector3D::crossProduct(a - center, b - center), n) < 0.f)
+                std::swap(a, b);   // Sens direct vu de -x (GL_CULL_FACE)
+            // Chair en couleur de sommet : la texture de peau ne s’applique pas ici
+            half.push_back({ center, n, uv, flesh, 1.f });
+            half.push_back({ a,      n, uv, flesh, 1.f });
+            half.push_back({ b,      n, uv, flesh, 1.f });
+        }
+    }
+    return half;
 }
-
@@ -0,0 +1,174 @@
+#include "projectilesim.h"
+#include <cmath>
+
+void ProjectileSim::reserve(std::size_t n)
+{
+    for (auto* v : { &m_a.px, &m_a.py, &m_a.pz, &m_a.prevX, &m_a.prevY, &m_a.prevZ,
+                     &m_a.x0, &m_a.y0, &m_a.z0, &m_a.tx, &m_a.ty, &m_a.tz, &m_a.vx, &m_a.vy, &m_a.vz,
+                     &m_a.time, &m_a.rot, &m_a.prevRot, &m_a.size })
+        v->reserve(n);
+    for (auto* v : { &m_a.shape, &m_a.axis, &m_a.flags })
+        v->reserve(n);
+}
+
+void ProjectileSim::clear()
+{
+    for (auto* v : { &m_a.px, &m_a.py, &m_a.pz, &m_a.prevX, &m_a.prevY, &m_a.prevZ,
+                     &m_a.x0, &m_a.y0, &m_a.z0, &m_a.tx, &m_a.ty, &m_a.tz, &m_a.vx, &m_a.vy, &m_a.vz,
+                     &m_a.time, &m_a.rot, &m_a.prevRot, &m_a.size })
+        v->clear();
+    for (auto* v : { &m_a.shape, &m_a.axis, &m_a.flags })
+        v->clear();
+}
+
+int ProjectileSim::add(int shape, const Vec3& start, const Vec3& target, float scale)
+{
+    const int i = int(size());
+    resize(size() + 1);
+    m_a.size[i] = scale;
+    respawn(i, shape, start, target);
+    return i;
+}
+
+void ProjectileSim::resize(std::size_t n)
+{
+    for (auto* v : { &m_a.px, &m_a.py, &m_a.pz, &m_a.prevX, &m_a.prevY, &m_a.prevZ,
+                     &m_a.x0, &m_a.y0, &m_a.z0, &m_a.tx, &m_a.ty, &m_a.tz, &m_a.vx, &m_a.vy, &m_a.vz,
+                     &m_a.time, &m_a.rot, &m_a.prevRot })
+        v->resize(n, 0.f);
+    m_a.size.resize(n, 1.f);
+    for (auto* v : { &m_a.shape, &m_a.axis, &m_a.flags })
+        v->resize(n, 0);
+}
+
+void ProjectileSim::respawn(int i, int shape, const Vec3& start, const Vec3& target)
+{
+    m_a.px[i] = m_a.prevX[i] = m_a.x0[i] = start.x;
+    m_a.py[i] = m_a.prevY[i] = m_a.y0[i] = start.y;
+    m_a.pz[i] = m_a.prevZ[i] = m_a.z0[i] = start.z;
+    m_a.tx[i] = target.x;
+    m_a.ty[i] = target.y;
+    m_a.tz[i] = target.z;
+    const Vec3 v = solveLaunch(start, target);
+    m_a.vx[i] = v.x;
+    m_a.vy[i] = v.y;
+    m_a.vz[i] = v.z;
+    m_a.time[i]    = 0.f;
+    m_a.rot[i]     = 0.f;
+    m_a.prevRot[i] = 0.f;
+    m_a.shape[i]   = std::uint8_t(shape);
+    m_a.axis[i]    = std::uint8_t((m_a.axis[i] + 1) % kAxisCount);
+    m_a.flags[i]   = Active | Visible;
+}
+
+void ProjectileSim::launch(int i, const Launch& l)
+{
+    m_a.px[i] = m_a.prevX[i] = m_a.x0[i] = l.start.x;
+    m_a.py[i] = m_a.prevY[i] = m_a.y0[i] = l.start.y;
+    m_a.pz[i] = m_a.prevZ[i] = m_a.z0[i] = l.start.z;
+    m_a.tx[i] = l.start.x;
+    m_a.ty[i] = l.start.y;
+    m_a.tz[i] = kNoTargetZ;
+    m_a.vx[i] = l.velocity.x;
+    m_a.vy[i] = l.velocity.y;
+    m_a.vz[i] = l.velocity.z;
+    m_a.time[i]    = 0.f;
+    m_a.rot[i]     = l.rot;
+    m_a.prevRot[i] = l.rot;
+    m_a.size[i]    = l.size;
+    m_a.shape[i]   = std::uint8_t(l.shape);
+    m_a.axis[i]    = std::uint8_t(l.axis % kAxisCount);
+    m_a.flags[i]   = l.flags;
+}
+
+ProjectileSim::Vec3 ProjectileSim::velocity(int i) const
+{
+    return { m_a.vx[i], m_a.vy[i] - kGravity * m_a.time[i], m_a.vz[i] };
+}
+
+ProjectileSim::Vec3 ProjectileSim::solveLaunch(const Vec3& start, const Vec3& target,
+                                               float alphaDeg, float g)
+{
+    // Tir balistique à angle fixe : V0 tel que la parabole passe par la cible
+    const float alpha = alphaDeg * float(M_PI) / 180.f;
+    const float dx = target.x - start.x;
+    const float dy = target.y - start.y;
+    const float dz = target.z - start.z;
+    const float d  = std::sqrt(dx * dx + dz * dz);
+    if (d <= 0.f)
+        return {};
+    const float rise = d * std::tan(alpha) - dy;
+    if (rise <= 0.f)
+        return {};   // Cible hors d’atteinte à cet angle : tir vertical nul
+
+    const float v0 = (d / std::cos(alpha)) * std::sqrt(g / (2.f * rise));
+    const float vh = v0 * std::cos(alpha) / d;   // Composante horizontale / d
+    return { dx * vh, v0 * std::sin(alpha), dz * vh };
+}
+
+void ProjectileSim::step(float dt)
+{
+    const std::size_t n = size();
+    const float halfG = 0.5f * kGravity;
+
+    float* __restrict px = m_a.px.data();
+    float* __restrict py = m_a.py.data();
+    float* __restrict pz = m_a.pz.data();
+    float* __restrict qx = m_a.prevX.data();
+    float* __restrict qy = m_a.prevY.data();
+    float* __restrict qz = m_a.prevZ.data();
+    float* __restrict time = m_a.time.data();
+    float* __restrict rot  = m_a.rot.data();
+    float* __restrict prot = m_a.prevRot.data();
+    const float* __restrict x0 = m_a.x0.data();
+    const float* __restrict y0 = m_a.y0.data();
+    const float* __restrict z0 = m_a.z0.data();
+    const float* __restrict vx = m_a.vx.data();
+    const float* __restrict vy = m_a.vy.data();
+    const float* __restrict vz = m_a.vz.data();
+    const float* __restrict tz = m_a.tz.data();
+    const std::uint8_t* __restrict flags = m_a.flags.data();
+
+    // Boucle sans branche : les projectiles inactifs gardent t et l’angle,
+    // leur position est simplement réévaluée au même instant.
+    // ivdep : les tableaux SoA ne se chevauchent jamais (évite les tests d’alias).
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC ivdep
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        const float live = float(int(flags[i]) & Active);   // Active = bit 0
+
+        qx[i] = px[i]; qy[i] = py[i]; qz[i] = pz[i];
+        prot[i] = rot[i];
+
+        const float t = time[i] + dt * live;
+        time[i] = t;
+        rot[i] += kRotSpeed * dt * live;   // Non borné : remis à 0 à chaque respawn
+
+        px[i] = x0[i] + vx[i] * t;
+        py[i] = y0[i] + (vy[i] - halfG * t) * t;
+        pz[i] = z0[i] + vz[i] * t;
+    }
+
+    // Arrivée à la cible ou chute sous le sol : désactivation (boucle séparée).
+    // Reached est posé dans le même pas, avant que Active ne disparaisse.
+    std::uint8_t* fl = m_a.flags.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint8_t live    = fl[i] & Active;
+        const std::uint8_t reached = std::uint8_t(live & std::uint8_t(pz[i] >= kGoalZ));
+        const std::uint8_t done    = std::uint8_t((pz[i] >= tz[i]) | (py[i] < kKillY));
+        fl[i] = std::uint8_t((fl[i] | (reached << 3)) & ~done);   // Reached = bit 3, efface Active
+    }
+}
+
+ProjectileSim::Vec3 ProjectileSim::interpolatedPosition(int i, float alpha) const
+{
+    return { m_a.prevX[i] + (m_a.px[i] - m_a.prevX[i]) * alpha,
+             m_a.prevY[i] + (m_a.py[i] - m_a.prevY[i]) * alpha,
+             m_a.prevZ[i] + (m_a.pz[i] - m_a.prevZ[i]) * alpha };
+}
+
+float ProjectileSim::interpolatedAngle(int i, float alpha) const
+{
+    return m_a.prevRot[i] + (m_a.rot[i] - m_a.prevRot[i]) * alpha;
+}
@@ -0,0 +1,109 @@
+#ifndef PROJECTILESIM_H
+#define PROJECTILESIM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Classe ProjectileSim :
+ * → Cœur de simulation des projectiles, sans OpenGL ni Qt.
+ * → Stockage "structure of arrays" : un tableau contigu par champ (positions,
+ *   paramètres de lancement, temps, rotation, drapeaux), pour que step() évalue
+ *   toutes les trajectoires en une boucle vectorisable.
+ * → Les indices sont stables : un slot est recyclé par respawn(), jamais déplacé.
+ */
+class ProjectileSim
+{
+public:
+    struct Vec3 { float x = 0.f, y = 0.f, z = 0.f; };
+
+    // Drapeaux par projectile
+    enum Flag : std::uint8_t {
+        Active   = 1 << 0,   // simulé et collisionnable
+        Visible  = 1 << 1,   // dessiné
+        Mirrored = 1 << 2,   // demi-mesh retourné (fragment gauche)
+        Reached  = 1 << 3    // a franchi kGoalZ en étant actif (remis à zéro au respawn)
+    };
+
+    static constexpr float kLaunchAngleDeg = 40.f;   // Angle de tir
+    static constexpr float kGravity        = 9.8f;   // m/s²
+    static constexpr float kRotSpeed       = 360.f;  // °/s
+    static constexpr int   kAxisCount      = 4;      // cf. Projectile::kAxes
+    static constexpr float kKillY          = -1.f;   // Sous le sol : désactivé
+    static constexpr float kNoTargetZ      = 1e9f;   // tz d’un tir sans cible
+    static constexpr float kGoalZ          = 11.f;   // Ligne de défaite, avant la cible (tz = 12)
+
+    // Tir à vitesse imposée (fragments) : pas de cible, fin sous kKillY
+    struct Launch {
+        int          shape    = 0;
+        Vec3         start;
+        Vec3         velocity;
+        float        size     = 1.f;
+        float        rot      = 0.f;   // Angle initial (°), repris du parent
+        int          axis     = 0;
+        std::uint8_t flags    = Active | Visible;
+    };
+
+    //=== Tableaux SoA (lecture seule hors de la classe) ===========================
+    struct Arrays {
+        std::vector<float>        px, py, pz;          // Position courante
+        std::vector<float>        prevX, prevY, prevZ; // Position au pas précédent
+        std::vector<float>        x0, y0, z0;          // Point de lancement
+        std::vector<float>        tx, ty, tz;          // Point cible
+        std::vector<float>        vx, vy, vz;          // Vitesse de lancement (résolue au respawn)
+        std::vector<float>        time;                // Temps depuis le lancement (s)
+        std::vector<float>        rot, prevRot;        // Angle de rotation (°)
+        std::vector<float>        size;                // Échelle du modèle
+        std::vector<std::uint8_t> shape;               // Projectile::Shape
+        std::vector<std::uint8_t> axis;                // Index dans Projectile::kAxes
+        std::vector<std::uint8_t> flags;               // Combinaison de Flag
+    };
+
+    void        reserve(std::size_t n);
+    void        clear();
+    std::size_t size() const { return m_a.time.size(); }
+    const Arrays& data() const { return m_a; }
+
+    // Ajoute un projectile et retourne son indice
+    int  add(int shape, const Vec3& start, const Vec3& target, float scale = 1.f);
+    // Ajoute des slots inactifs (pool préalloué)
+    void resize(std::size_t n);
+    // Relance le slot i depuis start (axe de rotation suivant, sans interpolation)
+    void respawn(int i, int shape, const Vec3& start, const Vec3& target);
+    // Relance le slot i avec une vitesse imposée
+    void launch(int i, const Launch& l);
+
+    Vec3 position(int i) const { return { m_a.px[i], m_a.py[i], m_a.pz[i] }; }
+    Vec3 velocity(int i) const;   // Vitesse instantanée (v0 + g·t)
+
+    bool isActive(int i) const  { return m_a.flags[i] & Active; }
+    bool isVisible(int i) const { return m_a.flags[i] & Visible; }
+    bool hasReached(int i) const { return m_a.flags[i] & Reached; }
+    void setActive(int i, bool on)  { setFlag(i, Active, on); }
+    void setVisible(int i, bool on) { setFlag(i, Visible, on); }
+
+    // Un pas fixe pour tous les projectiles actifs ; désactive ceux arrivés à la cible
+    // ou tombés sous kKillY. Marque Reached ceux qui, actifs, ont atteint kGoalZ :
+    // un grand pas peut franchir kGoalZ et la cible d’un coup, Active ne suffit pas.
+    // Position = p0 + v·t + ½·g·t², la vitesse étant résolue une fois au respawn.
+    void step(float dt);
+
+    // Vitesse initiale d’un tir à alphaDeg qui passe par target (g vers -y)
+    static Vec3 solveLaunch(const Vec3& start, const Vec3& target,
+                            float alphaDeg = kLaunchAngleDeg, float g = kGravity);
+
+    // État interpolé entre le pas précédent (alpha = 0) et le pas courant (alpha = 1)
+    Vec3  interpolatedPosition(int i, float alpha) const;
+    float interpolatedAngle(int i, float alpha) const;
+
+private:
+    void setFlag(int i, Flag f, bool on)
+    {
+        m_a.flags[i] = on ? std::uint8_t(m_a.flags[i] | f) : std::uint8_t(m_a.flags[i] & ~f);
+    }
+
+    Arrays m_a;
+};
+
+#endif // PROJECTILESIM_H
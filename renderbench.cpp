@@ -0,0 +1,186 @@
+#include "renderbench.h"
+#include "gamescene.h"
+#include "samplestats.h"
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOpenGLFramebufferObject>
+#include <QSurfaceFormat>
+#include <QtMath>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+string jsonEscape(const string& text)
+{
+    string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Une série de mesures par colonne : sim, phases de GameScene::paintGL, frame complète
+constexpr int kSeriesCount = GameScene::kRenderPhaseCount + 2;
+
+string seriesName(int series)
+{
+    if (series == 0)                  return "sim";
+    if (series <= GameScene::kRenderPhaseCount) return GameScene::renderPhaseName(series - 1);
+    return "paint";
+}
+
+} // namespace
+
+int RenderBench::run(const Options& options, ostream& out)
+{
+    const int width  = max(1, options.width);
+    const int height = max(1, options.height);
+
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setDepthBufferSize(24);
+
+    QOpenGLContext context;
+    context.setFormat(format);
+    if (!context.create()) {
+        cerr << "Render bench: no OpenGL 3.3 core context available" << endl;
+        return 1;
+    }
+    QOffscreenSurface surface;
+    surface.setFormat(context.format());
+    surface.create();
+    if (!context.makeCurrent(&surface)) {
+        cerr << "Render bench: cannot make the offscreen context current" << endl;
+        return 1;
+    }
+
+    QOpenGLFunctions* gl = context.functions();
+    const string renderer = reinterpret_cast<const char*>(gl->glGetString(GL_RENDERER));
+
+    auto fbo = make_unique<QOpenGLFramebufferObject>(width, height, QOpenGLFramebufferObject::Depth);
+    fbo->bind();
+
+    std::srand(1);   // randomX : même vague d’une exécution à l’autre
+
+    const int warmup = min(10, max(1, options.frames / 10));
+    vector<array<double, kSeriesCount>> rows;
+    rows.reserve(options.frames);
+    vector<pair<int, int>> glCounts;
+    glCounts.reserve(options.frames);
+    int restarts = 0;
+    int particleEvictions = 0;   // Explosions visibles coupées (liste d’émetteurs pleine)
+
+    {
+        // Même code que la fenêtre de jeu, piloté hors widget avec le contexte courant
+        GameScene scene;
+        scene.setAudioEnabled(false);
+        scene.setProjectileCount(options.projectiles);
+        scene.setSimulationHz(options.simulationHz);
+        scene.setPhaseTiming(true);
+
+        pair<int, int> lastCounts;
+        QObject::connect(&scene, &GameScene::glStatsChanged,
+                         [&lastCounts](int calls, int draws) { lastCounts = { calls, draws }; });
+
+        scene.initializeGL();
+        scene.resizeGL(width, height);
+        scene.restartGame();
+
+        // Horloge de jeu scriptée (ms depuis le dernier restart) : un pas par frame en
+        // moyenne, sans dépendre de la vitesse de la machine
+        const double dt = scene.m_simStep;
+        int gameFrame = 0;
+        scene.m_lastTickMs = 0;
+        for (int frame = 0; frame < warmup + options.frames; ++frame) {
+            // Sabre en huit devant la caméra : coupes régulières, explosions et fragments
+            const float t = float(frame * dt);
+            const QVector3D sword(4.f * qSin(float(M_PI) * t),
+                                  1.5f + qSin(2.f * float(M_PI) * t),
+                                  6.5f);
+
+            // Même chemin que tick() : historique du sabre, accumulateur, interpolation
+            const auto t0 = chrono::steady_clock::now();
+            const qint64 nowMs = qRound64(++gameFrame * dt * 1000.0);
+            scene.recordSwordSample(sword, nowMs);
+            scene.advance(dt, nowMs);
+            if (scene.m_gameOver) {
+                scene.restartGame();
+                scene.m_lastTickMs = 0;
+                gameFrame = 0;
+                ++restarts;
+            }
+            const auto t1 = chrono::steady_clock::now();
+
+            // QOpenGLWidget fixe normalement viewport et FBO avant paintGL
+            fbo->bind();
+            gl->glViewport(0, 0, width, height);
+            scene.paintGL();
+            gl->glFinish();
+            const auto t2 = chrono::steady_clock::now();
+
+            if (frame < warmup)
+                continue;
+
+            array<double, kSeriesCount> row{};
+            row[0] = chrono::duration<double, milli>(t1 - t0).count();
+            for (int p = 0; p < GameScene::kRenderPhaseCount; ++p)
+                row[1 + p] = scene.lastPhaseNs()[p] * 1e-6;
+            row[kSeriesCount - 1] = chrono::duration<double, milli>(t2 - t1).count();
+            rows.push_back(row);
+            glCounts.push_back(lastCounts);
+        }
+
+        particleEvictions = scene.m_particles.evictions();
+        fbo->release();
+    }   // GameScene libère ses ressources GL tant que le contexte est courant
+
+    fbo.reset();
+    context.doneCurrent();
+
+    if (!options.json) {
+        out << "frame";
+        for (int s = 0; s < kSeriesCount; ++s) out << ',' << seriesName(s) << "_ms";
+        out << ",gl_calls,draws\n";   // Appels émis par la scène, cf. glstats.h
+        for (size_t i = 0; i < rows.size(); ++i) {
+            out << i;
+            for (double v : rows[i]) out << ',' << v;
+            out << ',' << glCounts[i].first << ',' << glCounts[i].second << '\n';
+        }
+        return 0;
+    }
+
+    out << "{\n"
+        << "  \"renderer\": \"" << jsonEscape(renderer) << "\",\n"
+        << "  \"projectiles\": " << options.projectiles << ",\n"
+        << "  \"frames\": " << rows.size() << ",\n"
+        << "  \"width\": " << width << ",\n"
+        << "  \"height\": " << height << ",\n"
+        << "  \"restarts\": " << restarts << ",\n"
+        << "  \"particle_evictions\": " << particleEvictions << ",\n"
+        << "  \"gl_calls_max\": "
+        << (glCounts.empty() ? 0 : max_element(glCounts.begin(), glCounts.end())->first) << ",\n"
+        << "  \"phases_ms\": {\n";
+    for (int s = 0; s < kSeriesCount; ++s) {
+        vector<double> values;
+        values.reserve(rows.size());
+        for (const auto& row : rows) values.push_back(row[s]);
+        const samplestats::Summary sum = samplestats::summarize(std::move(values));
+        out << "    \"" << seriesName(s) << "\": { \"mean\": " << sum.mean
+            << ", \"p50\": " << sum.p50 << ", \"p95\": " << sum.p95
+            << ", \"max\": " << sum.max << " }" << (s + 1 < kSeriesCount ? "," : "") << '\n';
+    }
+    out << "  }\n}\n";
+    return 0;
+}
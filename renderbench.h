@@ -0,0 +1,39 @@
+#ifndef RENDERBENCH_H
+#define RENDERBENCH_H
+
+#include <ostream>
+
+/*
+ * Classe RenderBench :
+ * → Mode headless : le même code GameScene (initializeGL / advance / paintGL) rendu
+ *   dans un FBO sur un QOffscreenSurface, sans fenêtre ni GPU (Mesa llvmpipe sur les
+ *   serveurs de build : QT_QPA_PLATFORM=offscreen LIBGL_ALWAYS_SOFTWARE=1).
+ * → Scène scriptée : N projectiles (positions de lancement reproductibles), sabre en
+ *   balayage en huit ; la partie est relancée à chaque game over.
+ * → Chaque frame avance l’horloge de jeu d’un pas de simulation et passe par le chemin
+ *   de tick() (historique du sabre, accumulateur, interpolation) ; seul le temps réel
+ *   mesuré par tick() est remplacé par ce pas.
+ * → M frames enchaînées sans attente, chronométrées par phase (setup, room, grid,
+ *   sword, projectiles, particles) : CSV par frame, ou résumé JSON (moyenne, p50,
+ *   p95, max).
+ */
+class RenderBench
+{
+public:
+    struct Options {
+        int    projectiles  = 50;     // Taille de la vague
+        int    frames       = 300;    // Frames mesurées (hors préchauffage)
+        int    width        = 1280;   // Taille du FBO
+        int    height       = 720;
+        double simulationHz = 60.0;   // Un pas de simulation par frame
+        bool   json         = false;  // Résumé JSON au lieu du CSV par frame
+    };
+
+    /**
+     * Exécute le banc et écrit les mesures dans out.
+     * @return 0 si succès, 1 si le contexte OpenGL 3.3 hors écran est indisponible
+     */
+    static int run(const Options& options, std::ostream& out);
+};
+
+#endif // RENDERBENCH_H
@@ -0,0 +1,48 @@
+#ifndef SAMPLESTATS_H
+#define SAMPLESTATS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/*
+ * Résumé d’une série de mesures : moyenne, percentiles, maximum.
+ * → Une seule définition du percentile pour --latency-probe, --render-bench et
+ *   bench_detection : valeur triée de rang floor(n·q), bornée au dernier élément.
+ * → Série vide : tout à zéro (count = 0).
+ */
+namespace samplestats {
+
+struct Summary {
+    std::size_t count = 0;
+    double      mean  = 0.0;
+    double      p50   = 0.0;
+    double      p95   = 0.0;
+    double      p99   = 0.0;
+    double      max   = 0.0;
+};
+
+// values est pris par valeur : trié sur place
+inline Summary summarize(std::vector<double> values)
+{
+    Summary s;
+    if (values.empty())
+        return s;
+
+    double total = 0.0;
+    for (double v : values) total += v;
+    std::sort(values.begin(), values.end());
+    auto at = [&](double q) { return values[std::min(values.size() - 1, std::size_t(values.size() * q))]; };
+
+    s.count = values.size();
+    s.mean  = total / values.size();
+    s.p50   = at(0.50);
+    s.p95   = at(0.95);
+    s.p99   = at(0.99);
+    s.max   = values.back();
+    return s;
+}
+
+} // namespace samplestats
+
+#endif // SAMPLESTATS_H
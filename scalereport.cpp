@@ -0,0 +1,106 @@
+#include "scalereport.h"
+#include "framesource.h"
+#include "test_detectmultiscale.h"
+#include "alloccounter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+int runScaleReport(const string& sourceSpec, const string& cascadePath,
+                   int frameCount, ostream& out)
+{
+    try {
+        unique_ptr<FrameSource> source = FrameSource::fromSpec(sourceSpec);
+        auto* synthetic = dynamic_cast<SyntheticFrameSource*>(source.get());
+        if (synthetic) synthetic->setFps(0.0);   // Frames capturées d’avance : pas de cadence caméra
+
+        // Capture unique : toutes les échelles voient exactement les mêmes frames
+        vector<Mat>     frames;
+        vector<Point2f> truth;
+        for (int i = 0; i < frameCount; ++i) {
+            Mat f;
+            if (!source->grab(f)) break;
+            if (synthetic) truth.push_back(synthetic->centerAt(synthetic->frameIndex() - 1));
+            frames.push_back(f);
+        }
+        if (frames.empty()) {
+            cerr << "Scale report: no frame captured from " << sourceSpec << endl;
+            return 1;
+        }
+
+        alloccount::install();
+        PalmDetector detector(std::move(source), cascadePath);
+        const double scales[] = { 1.0, 0.5, 0.25 };
+        vector<Point> fullRes(frames.size(), Point(-1, -1));
+        bool overBudget = false;
+
+        out << "scale,frames,detected,mean_ms,p95_ms,fps,mean_err_px,max_err_px,"
+               "steady_allocs,steady_exempt_allocs,reference\n";
+        for (double scale : scales) {
+            detector.setProcessingScale(scale);
+            detector.resetTracking();
+
+            vector<double> times;
+            double errSum = 0.0, errMax = 0.0;
+            int detected = 0, compared = 0;
+            vector<Point> centers;
+            uint64_t steadyAllocs = 0;   // max par frame, hors frames de chauffe
+            uint64_t steadyExempt = 0;   // idem, appels OpenCV exemptés (cf. alloccounter.h)
+            const size_t warmup = min<size_t>(5, frames.size() / 2);
+
+            for (size_t i = 0; i < frames.size(); ++i) {
+                centers.clear();
+                const auto t0 = chrono::steady_clock::now();
+                const AllocScope allocs;
+                const uint64_t   exempt0 = alloccount::threadExemptCount();
+                detector.detect(frames[i], centers);
+                times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count());
+                if (i >= warmup) {
+                    steadyAllocs = max(steadyAllocs, allocs.count());
+                    steadyExempt = max(steadyExempt, alloccount::threadExemptCount() - exempt0);
+                }
+                if (centers.empty()) continue;
+
+                ++detected;
+                if (scale == 1.0) fullRes[i] = centers[0];
+
+                Point2f ref;
+                if (synthetic)               ref = truth[i];
+                else if (fullRes[i].x >= 0)  ref = fullRes[i];
+                else                         continue;
+                const double err = norm(Point2f(centers[0]) - ref);
+                errSum += err;
+                errMax  = max(errMax, err);
+                ++compared;
+            }
+
+            const double total = [&] { double t = 0; for (double v : times) t += v; return t; }();
+            sort(times.begin(), times.end());
+            const double mean = total / times.size();
+            const double p95  = times[min(times.size() - 1, size_t(times.size() * 0.95))];
+
+            out << scale << ',' << frames.size() << ',' << detected << ','
+                << mean << ',' << p95 << ',' << (mean > 0 ? 1000.0 / mean : 0.0) << ','
+                << (compared ? errSum / compared : 0.0) << ',' << errMax << ','
+                << (alloccount::enabled() ? to_string(steadyAllocs) : string("n/a")) << ','
+                << (alloccount::enabled() ? to_string(steadyExempt) : string("n/a")) << ','
+                << (synthetic ? "synthetic" : "scale_1.0") << '\n';
+
+            if (alloccount::enabled() && steadyAllocs > alloccount::kSteadyFrameBudget) {
+                cerr << "Scale report: " << steadyAllocs << " allocation(s) per frame at scale "
+                     << scale << " outside the exempted OpenCV calls (budget "
+                     << alloccount::kSteadyFrameBudget << ")" << endl;
+                overBudget = true;
+            }
+        }
+        return overBudget ? 1 : 0;
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+}
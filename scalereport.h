@@ -0,0 +1,23 @@
+#ifndef SCALEREPORT_H
+#define SCALEREPORT_H
+
+#include <ostream>
+#include <string>
+
+/**
+ * Rapport précision / vitesse de PalmDetector pour chaque échelle de traitement
+ * (1.0, 0.5, 0.25), afin de choisir l’échelle adaptée à une caméra donnée.
+ * Les mêmes frames sont rejouées à chaque échelle ; la référence est la vérité
+ * terrain pour une source synthétique, sinon le résultat à pleine résolution.
+ * @param sourceSpec  source des frames (cf. FrameSource::fromSpec)
+ * @param cascadePath XML du cascade palm
+ * @param frameCount  nombre de frames capturées puis rejouées
+ * @param out         sortie CSV
+ * Compilé avec SDD_COUNT_ALLOCATIONS, échoue aussi si une échelle dépasse
+ * alloccount::kSteadyFrameBudget allocations par frame en régime établi.
+ * @return 0 si succès, 1 sinon
+ */
+int runScaleReport(const std::string& sourceSpec, const std::string& cascadePath,
+                   int frameCount, std::ostream& out);
+
+#endif // SCALEREPORT_H
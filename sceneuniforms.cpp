@@ -0,0 +1,59 @@
+#include "sceneuniforms.h"
+#include <QOpenGLShaderProgram>
+#include <QDebug>
+#include <algorithm>
+
+void SceneUniforms::initialize()
+{
+    initializeOpenGLFunctions();
+
+    glGenBuffers(1, &m_ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(SceneBlock), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Le binding reste en place pour toute la durée du contexte
+    glBindBufferBase(GL_UNIFORM_BUFFER, kBindingPoint, m_ubo);
+}
+
+void SceneUniforms::destroy()
+{
+    if (m_ubo) {
+        glDeleteBuffers(1, &m_ubo);
+        m_ubo = 0;
+    }
+}
+
+bool SceneUniforms::attach(QOpenGLShaderProgram& program)
+{
+    const GLuint index = glGetUniformBlockIndex(program.programId(), "SceneBlock");
+    if (index == GL_INVALID_INDEX) {
+        qWarning() << "SceneUniforms: SceneBlock absent du programme" << program.programId();
+        return false;
+    }
+    glUniformBlockBinding(program.programId(), index, kBindingPoint);
+    return true;
+}
+
+void SceneUniforms::update(const QMatrix4x4& view, const QMatrix4x4& proj,
+                           const QVector3D& lightDir, const QVector3D& viewPos)
+{
+    std::copy(view.constData(), view.constData() + 16, m_block.view);
+    std::copy(proj.constData(), proj.constData() + 16, m_block.proj);
+    m_block.lightDir[0] = lightDir.x(); m_block.lightDir[1] = lightDir.y(); m_block.lightDir[2] = lightDir.z();
+    m_block.viewPos[0]  = viewPos.x();  m_block.viewPos[1]  = viewPos.y();  m_block.viewPos[2]  = viewPos.z();
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(SceneBlock), &m_block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void ShaderLocations::resolve(QOpenGLShaderProgram& program)
+{
+    model         = program.uniformLocation("uModel");
+    normalMatrix  = program.uniformLocation("uNormalMatrix");
+    hasTex        = program.uniformLocation("uHasTex");
+    texture       = program.uniformLocation("uTexture");
+    emissionColor = program.uniformLocation("uEmissionColor");
+    emissionPower = program.uniformLocation("uEmissionPower");
+}
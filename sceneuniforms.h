@@ -0,0 +1,62 @@
+#ifndef SCENEUNIFORMS_H
+#define SCENEUNIFORMS_H
+
+#include "glstats.h"
+#include <QMatrix4x4>
+#include <QVector3D>
+
+class QOpenGLShaderProgram;
+
+/*
+ * Bloc d’uniforms partagé par tous les shaders de la scène (layout std140).
+ * → Doit correspondre au bloc GLSL "SceneBlock" :
+ *     layout(std140) uniform SceneBlock { mat4 uView; mat4 uProj; vec4 uLightDir; vec4 uViewPos; };
+ * → vec3 occupe 16 octets en std140 : lumière et caméra sont stockées en vec4 (w ignoré).
+ */
+struct SceneBlock {
+    float view[16];      // Matrice de vue (column-major)
+    float proj[16];      // Matrice de projection (column-major)
+    float lightDir[4];   // Direction de la lumière (normalisée)
+    float viewPos[4];    // Position de la caméra
+};
+static_assert(sizeof(SceneBlock) == 160, "SceneBlock doit suivre le layout std140");
+
+/*
+ * Classe SceneUniforms :
+ * → Un UBO rempli une fois par frame (un seul glBufferSubData), attaché au point
+ *   de binding kBindingPoint : les programmes n’ont plus à recevoir vue/proj/lumière
+ *   draw par draw.
+ */
+class SceneUniforms : protected glstats::CountingFunctions
+{
+public:
+    static constexpr GLuint kBindingPoint = 0;
+
+    void initialize();                                  // Crée l’UBO (contexte GL courant)
+    void destroy();                                     // Libère l’UBO (contexte GL courant)
+    bool attach(QOpenGLShaderProgram& program);         // Relie le bloc du programme au binding
+
+    void update(const QMatrix4x4& view, const QMatrix4x4& proj,
+                const QVector3D& lightDir, const QVector3D& viewPos);
+
+private:
+    GLuint     m_ubo = 0;
+    SceneBlock m_block{};
+};
+
+/*
+ * Emplacements des uniforms par draw du shader de scène, résolus une fois après
+ * le link : glUniform*(location, ...) évite la recherche par nom à chaque appel.
+ */
+struct ShaderLocations {
+    int model         = -1;
+    int normalMatrix  = -1;
+    int hasTex        = -1;
+    int texture       = -1;
+    int emissionColor = -1;
+    int emissionPower = -1;
+
+    void resolve(QOpenGLShaderProgram& program);
+};
+
+#endif // SCENEUNIFORMS_H
@@ -35,22 +35,71 @@ LIBS += -L$$OPENCV_DIR/x64/mingw/lib \
 #----- sources / headers / forms -----
 SOURCES += \
     main.cpp \
+    alloccounter.cpp \
+    broadphase.cpp \
     mainwindow.cpp \
+    fragmentpool.cpp \
+    framesource.cpp \
     gamescene.cpp \
+    glstats.cpp \
+    latencyprobe.cpp \
+    meshregistry.cpp \
+    palmpipeline.cpp \
+    particlesystem.cpp \
+    perfprobe.cpp \
+    previewscaler.cpp \
     projectile.cpp \
+    projectilesim.cpp \
+    renderbench.cpp \
+    scalereport.cpp \
+    sceneuniforms.cpp \
+    skinsegment.cpp \
     sword.cpp \
+    texturecache.cpp \
+    tracer.cpp \
     test_detectmultiscale.cpp
       # test_detectmultiscale.cpp # <-- your palm-detect demo
 
 HEADERS += \
+    alloccounter.h \
+    broadphase.h \
     camera_window.h \
     mainwindow.h \
+    fragmentpool.h \
+    framesource.h \
     gamescene.h \
+    glstats.h \
+    latencyprobe.h \
+    latestvalue.h \
+    meshregistry.h \
+    palmpipeline.h \
+    particlesystem.h \
+    perfprobe.h \
+    previewimage.h \
+    previewscaler.h \
     projectile.h \
+    projectilesim.h \
+    renderbench.h \
+    samplestats.h \
+    scalereport.h \
+    sceneuniforms.h \
+    skinsegment.h \
     sword.h \
+    texturecache.h \
+    tracer.h \
     test_detectmultiscale.h
 
 FORMS   += mainwindow.ui
 
+# Lets GCC vectorise the SoA loops (ProjectileSim::step): no errno/trapping math,
+# and a cost model that allows alias/peel versioning at -O2
+*-g++*: QMAKE_CXXFLAGS += -fno-math-errno -fno-trapping-math -fvect-cost-model=dynamic
+
+# Compare the fused skin kernel with the original OpenCV chain on every frame
+# DEFINES += SDD_VERIFY_SKIN_KERNEL
+
+# Count heap allocations per thread (steady_allocs column of --scale-report)
+# DEFINES += SDD_COUNT_ALLOCATIONS
+
 # Optional: disable deprecated Qt 5 APIs
 # DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000
@@ -0,0 +1,379 @@
+#include "skinsegment.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SKIN_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#define SKIN_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace skin {
+
+namespace {
+
+// Coefficients de cv::cvtColor BGR2YCrCb (virgule fixe, yuv_shift = 14)
+constexpr int kShift = 14;
+constexpr int kR2Y   = 4899;
+constexpr int kG2Y   = 9617;
+constexpr int kB2Y   = 1868;
+constexpr int kYCr   = 11682;
+constexpr int kYCb   = 9241;
+constexpr int kRound = 1 << (kShift - 1);
+
+inline std::uint8_t saturate(int v)
+{
+    return static_cast<std::uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// Cr/Cb d’un pixel, arrondi identique à CV_DESCALE ; delta = 128 << 14 sorti du décalage
+inline void crcbScalar(const std::uint8_t* p, std::uint8_t& cr, std::uint8_t& cb)
+{
+    const int b = p[0], g = p[1], r = p[2];
+    const int y = (b * kB2Y + g * kG2Y + r * kR2Y + kRound) >> kShift;
+    cr = saturate((((r - y) * kYCr + kRound) >> kShift) + 128);
+    cb = saturate((((b - y) * kYCb + kRound) >> kShift) + 128);
+}
+
+inline bool inside(std::uint8_t v, std::uint8_t lo, std::uint8_t hi)
+{
+    return v >= lo && v <= hi;
+}
+
+//=== Scalaire ===================================================================
+
+void segmentRowScalar(const std::uint8_t* src, std::uint8_t* dst, int x, int width, const Thresholds& th)
+{
+    for (; x < width; ++x) {
+        std::uint8_t cr, cb;
+        crcbScalar(src + 3 * x, cr, cb);
+        dst[x] = (inside(cr, th.crMin, th.crMax) && inside(cb, th.cbMin, th.cbMax)) ? 255 : 0;
+    }
+}
+
+void crcbRowScalar(const std::uint8_t* src, std::uint8_t* cr, std::uint8_t* cb, int x, int width)
+{
+    for (; x < width; ++x)
+        crcbScalar(src + 3 * x, cr[x], cb[x]);
+}
+
+void thresholdRowScalar(const std::uint8_t* cr, const std::uint8_t* cb, std::uint8_t* dst,
+                        int x, int width, const Thresholds& th)
+{
+    for (; x < width; ++x)
+        dst[x] = (inside(cr[x], th.crMin, th.crMax) && inside(cb[x], th.cbMin, th.cbMax)) ? 255 : 0;
+}
+
+#ifdef SKIN_HAVE_X86_SIMD
+
+//=== SSSE3 : 16 pixels par itération ============================================
+
+// Désentrelace 16 pixels BGR (48 octets) en trois vecteurs B, G, R
+SKIN_TARGET("ssse3")
+inline void loadBgr16(const std::uint8_t* p, __m128i& b, __m128i& g, __m128i& r)
+{
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+
+    const __m128i b0 = _mm_setr_epi8( 0, 3, 6, 9,12,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1);
+    const __m128i b1 = _mm_setr_epi8(-1,-1,-1,-1,-1,-1, 2, 5, 8,11,14,-1,-1,-1,-1,-1);
+    const __m128i b2 = _mm_setr_epi8(-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, 1, 4, 7,10,13);
+    const __m128i g0 = _mm_setr_epi8( 1, 4, 7,10,13,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1);
+    const __m128i g1 = _mm_setr_epi8(-1,-1,-1,-1,-1, 0, 3, 6, 9,12,15,-1,-1,-1,-1,-1);
+    const __m128i g2 = _mm_setr_epi8(-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, 2, 5, 8,11,14);
+    const __m128i r0 = _mm_setr_epi8( 2, 5, 8,11,14,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1);
+    const __m128i r1 = _mm_setr_epi8(-1,-1,-1,-1,-1, 1, 4, 7,10,13,-1,-1,-1,-1,-1,-1);
+    const __m128i r2 = _mm_setr_epi8(-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, 0, 3, 6, 9,12,15);
+
+    b = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, b0), _mm_shuffle_epi8(v1, b1)), _mm_shuffle_epi8(v2, b2));
+    g = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, g0), _mm_shuffle_epi8(v1, g1)), _mm_shuffle_epi8(v2, g2));
+    r = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, r0), _mm_shuffle_epi8(v1, r1)), _mm_shuffle_epi8(v2, r2));
+}
+
+// (x * c + round) >> 14 sur 8 entiers 16 bits signés, résultat 16 bits
+SKIN_TARGET("ssse3")
+inline __m128i scaleShift8(__m128i x, __m128i coeffRound)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i lo  = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(x, one), coeffRound), kShift);
+    const __m128i hi  = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(x, one), coeffRound), kShift);
+    return _mm_packs_epi32(lo, hi);
+}
+
+// Y sur 8 pixels (entrées 16 bits)
+SKIN_TARGET("ssse3")
+inline __m128i luma8(__m128i b, __m128i g, __m128i r)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i cBG = _mm_setr_epi16(kB2Y, kG2Y, kB2Y, kG2Y, kB2Y, kG2Y, kB2Y, kG2Y);
+    const __m128i cR  = _mm_setr_epi16(kR2Y, kRound, kR2Y, kRound, kR2Y, kRound, kR2Y, kRound);
+    __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(b, g), cBG),
+                               _mm_madd_epi16(_mm_unpacklo_epi16(r, one), cR));
+    __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(b, g), cBG),
+                               _mm_madd_epi16(_mm_unpackhi_epi16(r, one), cR));
+    return _mm_packs_epi32(_mm_srai_epi32(lo, kShift), _mm_srai_epi32(hi, kShift));
+}
+
+// Cr/Cb saturés 8 bits pour 16 pixels
+SKIN_TARGET("ssse3")
+inline void crcb16(const std::uint8_t* p, __m128i& cr, __m128i& cb)
+{
+    __m128i b8, g8, r8;
+    loadBgr16(p, b8, g8, r8);
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i cCr  = _mm_setr_epi16(kYCr, kRound, kYCr, kRound, kYCr, kRound, kYCr, kRound);
+    const __m128i cCb  = _mm_setr_epi16(kYCb, kRound, kYCb, kRound, kYCb, kRound, kYCb, kRound);
+
+    __m128i crPart[2], cbPart[2];
+    for (int h = 0; h < 2; ++h) {
+        const __m128i b = h ? _mm_unpackhi_epi8(b8, zero) : _mm_unpacklo_epi8(b8, zero);
+        const __m128i g = h ? _mm_unpackhi_epi8(g8, zero) : _mm_unpacklo_epi8(g8, zero);
+        const __m128i r = h ? _mm_unpackhi_epi8(r8, zero) : _mm_unpacklo_epi8(r8, zero);
+        const __m128i y = luma8(b, g, r);
+        crPart[h] = _mm_add_epi16(scaleShift8(_mm_sub_epi16(r, y), cCr), half);
+        cbPart[h] = _mm_add_epi16(scaleShift8(_mm_sub_epi16(b, y), cCb), half);
+    }
+    cr = _mm_packus_epi16(crPart[0], crPart[1]);
+    cb = _mm_packus_epi16(cbPart[0], cbPart[1]);
+}
+
+// 0xFF si lo <= v <= hi (non signé)
+SKIN_TARGET("ssse3")
+inline __m128i inRange16(__m128i v, __m128i lo, __m128i hi)
+{
+    return _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, lo), v),
+                         _mm_cmpeq_epi8(_mm_min_epu8(v, hi), v));
+}
+
+SKIN_TARGET("ssse3")
+int segmentRowSsse3(const std::uint8_t* src, std::uint8_t* dst, int width, const Thresholds& th)
+{
+    const __m128i crLo = _mm_set1_epi8(char(th.crMin)), crHi = _mm_set1_epi8(char(th.crMax));
+    const __m128i cbLo = _mm_set1_epi8(char(th.cbMin)), cbHi = _mm_set1_epi8(char(th.cbMax));
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i cr, cb;
+        crcb16(src + 3 * x, cr, cb);
+        const __m128i m = _mm_and_si128(inRange16(cr, crLo, crHi), inRange16(cb, cbLo, cbHi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), m);
+    }
+    return x;
+}
+
+SKIN_TARGET("ssse3")
+int crcbRowSsse3(const std::uint8_t* src, std::uint8_t* crOut, std::uint8_t* cbOut, int width)
+{
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i cr, cb;
+        crcb16(src + 3 * x, cr, cb);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(crOut + x), cr);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cbOut + x), cb);
+    }
+    return x;
+}
+
+SKIN_TARGET("ssse3")
+int thresholdRowSsse3(const std::uint8_t* cr, const std::uint8_t* cb, std::uint8_t* dst,
+                      int width, const Thresholds& th)
+{
+    const __m128i crLo = _mm_set1_epi8(char(th.crMin)), crHi = _mm_set1_epi8(char(th.crMax));
+    const __m128i cbLo = _mm_set1_epi8(char(th.cbMin)), cbHi = _mm_set1_epi8(char(th.cbMax));
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i vcr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cr + x));
+        const __m128i vcb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cb + x));
+        const __m128i m   = _mm_and_si128(inRange16(vcr, crLo, crHi), inRange16(vcb, cbLo, cbHi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), m);
+    }
+    return x;
+}
+
+//=== AVX2 : 32 pixels par itération =============================================
+// Le désentrelacement reste en 128 bits (pshufb est intra-voie), l’arithmétique
+// 16/32 bits passe en 256 bits. unpack/pack étant intra-voie, l’ordre est conservé.
+
+SKIN_TARGET("avx2")
+inline __m256i scaleShift16(__m256i x, __m256i coeffRound)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i lo  = _mm256_srai_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(x, one), coeffRound), kShift);
+    const __m256i hi  = _mm256_srai_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(x, one), coeffRound), kShift);
+    return _mm256_packs_epi32(lo, hi);
+}
+
+SKIN_TARGET("avx2")
+inline void crcb32(const std::uint8_t* p, __m256i& cr, __m256i& cb)
+{
+    __m128i bA, gA, rA, bB, gB, rB;
+    loadBgr16(p,      bA, gA, rA);
+    loadBgr16(p + 48, bB, gB, rB);
+    const __m256i b8 = _mm256_inserti128_si256(_mm256_castsi128_si256(bA), bB, 1);
+    const __m256i g8 = _mm256_inserti128_si256(_mm256_castsi128_si256(gA), gB, 1);
+    const __m256i r8 = _mm256_inserti128_si256(_mm256_castsi128_si256(rA), rB, 1);
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one  = _mm256_set1_epi16(1);
+    const __m256i half = _mm256_set1_epi16(128);
+    const __m256i cBG  = _mm256_set1_epi32((kG2Y << 16) | kB2Y);
+    const __m256i cR   = _mm256_set1_epi32((kRound << 16) | kR2Y);
+    const __m256i cCr  = _mm256_set1_epi32((kRound << 16) | kYCr);
+    const __m256i cCb  = _mm256_set1_epi32((kRound << 16) | kYCb);
+
+    __m256i crPart[2], cbPart[2];
+    for (int h = 0; h < 2; ++h) {
+        const __m256i b = h ? _mm256_unpackhi_epi8(b8, zero) : _mm256_unpacklo_epi8(b8, zero);
+        const __m256i g = h ? _mm256_unpackhi_epi8(g8, zero) : _mm256_unpacklo_epi8(g8, zero);
+        const __m256i r = h ? _mm256_unpackhi_epi8(r8, zero) : _mm256_unpacklo_epi8(r8, zero);
+
+        const __m256i yLo = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(b, g), cBG),
+                                             _mm256_madd_epi16(_mm256_unpacklo_epi16(r, one), cR));
+        const __m256i yHi = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(b, g), cBG),
+                                             _mm256_madd_epi16(_mm256_unpackhi_epi16(r, one), cR));
+        const __m256i y   = _mm256_packs_epi32(_mm256_srai_epi32(yLo, kShift), _mm256_srai_epi32(yHi, kShift));
+
+        crPart[h] = _mm256_add_epi16(scaleShift16(_mm256_sub_epi16(r, y), cCr), half);
+        cbPart[h] = _mm256_add_epi16(scaleShift16(_mm256_sub_epi16(b, y), cCb), half);
+    }
+    cr = _mm256_packus_epi16(crPart[0], crPart[1]);
+    cb = _mm256_packus_epi16(cbPart[0], cbPart[1]);
+}
+
+SKIN_TARGET("avx2")
+inline __m256i inRange32(__m256i v, __m256i lo, __m256i hi)
+{
+    return _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, lo), v),
+                            _mm256_cmpeq_epi8(_mm256_min_epu8(v, hi), v));
+}
+
+SKIN_TARGET("avx2")
+int segmentRowAvx2(const std::uint8_t* src, std::uint8_t* dst, int width, const Thresholds& th)
+{
+    const __m256i crLo = _mm256_set1_epi8(char(th.crMin)), crHi = _mm256_set1_epi8(char(th.crMax));
+    const __m256i cbLo = _mm256_set1_epi8(char(th.cbMin)), cbHi = _mm256_set1_epi8(char(th.cbMax));
+    int x = 0;
+    for (; x + 32 <= width; x += 32) {
+        __m256i cr, cb;
+        crcb32(src + 3 * x, cr, cb);
+        const __m256i m = _mm256_and_si256(inRange32(cr, crLo, crHi), inRange32(cb, cbLo, cbHi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), m);
+    }
+    return x;
+}
+
+SKIN_TARGET("avx2")
+int crcbRowAvx2(const std::uint8_t* src, std::uint8_t* crOut, std::uint8_t* cbOut, int width)
+{
+    int x = 0;
+    for (; x + 32 <= width; x += 32) {
+        __m256i cr, cb;
+        crcb32(src + 3 * x, cr, cb);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(crOut + x), cr);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(cbOut + x), cb);
+    }
+    return x;
+}
+
+SKIN_TARGET("avx2")
+int thresholdRowAvx2(const std::uint8_t* cr, const std::uint8_t* cb, std::uint8_t* dst,
+                     int width, const Thresholds& th)
+{
+    const __m256i crLo = _mm256_set1_epi8(char(th.crMin)), crHi = _mm256_set1_epi8(char(th.crMax));
+    const __m256i cbLo = _mm256_set1_epi8(char(th.cbMin)), cbHi = _mm256_set1_epi8(char(th.cbMax));
+    int x = 0;
+    for (; x + 32 <= width; x += 32) {
+        const __m256i vcr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cr + x));
+        const __m256i vcb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cb + x));
+        const __m256i m   = _mm256_and_si256(inRange32(vcr, crLo, crHi), inRange32(vcb, cbLo, cbHi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), m);
+    }
+    return x;
+}
+
+#endif // SKIN_HAVE_X86_SIMD
+
+Isa resolve(Isa isa)
+{
+    return isa == Isa::Auto ? bestIsa() : isa;
+}
+
+} // namespace
+
+Isa bestIsa()
+{
+#ifdef SKIN_HAVE_X86_SIMD
+    static const Isa best = __builtin_cpu_supports("avx2")  ? Isa::Avx2
+                          : __builtin_cpu_supports("ssse3") ? Isa::Ssse3
+                                                            : Isa::Scalar;
+    return best;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+const char* isaName(Isa isa)
+{
+    switch (resolve(isa)) {
+    case Isa::Avx2:  return "avx2";
+    case Isa::Ssse3: return "ssse3";
+    default:         return "scalar";
+    }
+}
+
+void segmentBgr(const std::uint8_t* bgr, std::size_t bgrStep,
+                std::uint8_t* mask, std::size_t maskStep,
+                int width, int height, const Thresholds& th, Isa isa)
+{
+    isa = resolve(isa);
+    for (int y = 0; y < height; ++y) {
+        const std::uint8_t* src = bgr + y * bgrStep;
+        std::uint8_t*       dst = mask + y * maskStep;
+        int x = 0;
+#ifdef SKIN_HAVE_X86_SIMD
+        if (isa == Isa::Avx2)       x = segmentRowAvx2(src, dst, width, th);
+        else if (isa == Isa::Ssse3) x = segmentRowSsse3(src, dst, width, th);
+#endif
+        segmentRowScalar(src, dst, x, width, th);
+    }
+}
+
+void bgrToCrCb(const std::uint8_t* bgr, std::size_t bgrStep,
+               std::uint8_t* cr, std::size_t crStep,
+               std::uint8_t* cb, std::size_t cbStep,
+               int width, int height, Isa isa)
+{
+    isa = resolve(isa);
+    for (int y = 0; y < height; ++y) {
+        const std::uint8_t* src   = bgr + y * bgrStep;
+        std::uint8_t*       crRow = cr + y * crStep;
+        std::uint8_t*       cbRow = cb + y * cbStep;
+        int x = 0;
+#ifdef SKIN_HAVE_X86_SIMD
+        if (isa == Isa::Avx2)       x = crcbRowAvx2(src, crRow, cbRow, width);
+        else if (isa == Isa::Ssse3) x = crcbRowSsse3(src, crRow, cbRow, width);
+#endif
+        crcbRowScalar(src, crRow, cbRow, x, width);
+    }
+}
+
+void thresholdCrCb(const std::uint8_t* cr, std::size_t crStep,
+                   const std::uint8_t* cb, std::size_t cbStep,
+                   std::uint8_t* mask, std::size_t maskStep,
+                   int width, int height, const Thresholds& th, Isa isa)
+{
+    isa = resolve(isa);
+    for (int y = 0; y < height; ++y) {
+        const std::uint8_t* crRow = cr + y * crStep;
+        const std::uint8_t* cbRow = cb + y * cbStep;
+        std::uint8_t*       dst   = mask + y * maskStep;
+        int x = 0;
+#ifdef SKIN_HAVE_X86_SIMD
+        if (isa == Isa::Avx2)       x = thresholdRowAvx2(crRow, cbRow, dst, width, th);
+        else if (isa == Isa::Ssse3) x = thresholdRowSsse3(crRow, cbRow, dst, width, th);
+#endif
+        thresholdRowScalar(crRow, cbRow, dst, x, width, th);
+    }
+}
+
+} // namespace skin
@@ -0,0 +1,48 @@
+#ifndef SKINSEGMENT_H
+#define SKINSEGMENT_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Noyau de segmentation peau fusionné :
+ * → BGR → Cr/Cb → masque binaire (0/255) en une seule passe, sans cv::Mat intermédiaire.
+ * → Mêmes arrondis que cv::cvtColor(COLOR_BGR2YCrCb) 8 bits (virgule fixe 14 bits),
+ *   donc résultat identique à la chaîne cvtColor + inRange (cf. tests/test_skinsegment).
+ * → SSSE3 / AVX2 choisis à l’exécution, repli scalaire sinon.
+ * → Les pas (step) sont en octets : une ROI d’un cv::Mat se passe telle quelle.
+ */
+namespace skin {
+
+// Bornes Cr/Cb incluses (Y n’est pas filtré : [0,255])
+struct Thresholds {
+    std::uint8_t crMin = 125, crMax = 180;
+    std::uint8_t cbMin = 70,  cbMax = 140;
+};
+
+// Jeu d’instructions utilisé ; Auto = meilleur disponible sur la machine
+enum class Isa { Auto, Scalar, Ssse3, Avx2 };
+
+Isa         bestIsa();          // Meilleur ISA supporté par le CPU
+const char* isaName(Isa isa);   // "scalar", "ssse3", "avx2"
+
+// BGR → masque, passe unique (CLAHE désactivé)
+void segmentBgr(const std::uint8_t* bgr, std::size_t bgrStep,
+                std::uint8_t* mask, std::size_t maskStep,
+                int width, int height, const Thresholds& th, Isa isa = Isa::Auto);
+
+// BGR → plans Cr et Cb (pour appliquer CLAHE entre les deux étapes)
+void bgrToCrCb(const std::uint8_t* bgr, std::size_t bgrStep,
+               std::uint8_t* cr, std::size_t crStep,
+               std::uint8_t* cb, std::size_t cbStep,
+               int width, int height, Isa isa = Isa::Auto);
+
+// Plans Cr/Cb → masque
+void thresholdCrCb(const std::uint8_t* cr, std::size_t crStep,
+                   const std::uint8_t* cb, std::size_t cbStep,
+                   std::uint8_t* mask, std::size_t maskStep,
+                   int width, int height, const Thresholds& th, Isa isa = Isa::Auto);
+
+} // namespace skin
+
+#endif // SKINSEGMENT_H
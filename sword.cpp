@@ -148,21 +148,17 @@ void Sword::initialize() {
     m_vbo.release();
 }
 
-void Sword::render(QOpenGLShaderProgram& shader,
-                   const QMatrix4x4& view,
-                   const QMatrix4x4& proj)
+void Sword::render(const ShaderLocations& loc)
 {
-    shader.bind();
     QMatrix4x4 model;
 
     model.translate(m_position);
-    shader.setUniformValue("uModel", model);
-    shader.setUniformValue("uView",  view);
-    shader.setUniformValue("uProj",  proj);
-    shader.setUniformValue("uHasTex", 0);
+    const QMatrix3x3 normal;   // Translation seule
+    glUniformMatrix4fv(loc.model, 1, GL_FALSE, model.constData());
+    glUniformMatrix3fv(loc.normalMatrix, 1, GL_FALSE, normal.constData());
+    glUniform1i(loc.hasTex, 0);
 
-    m_vao.bind();
+    glBindVertexArray(m_vao.objectId());
     glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
-    m_vao.release();
-    shader.release();
+    glBindVertexArray(0);
 }
@@ -1,18 +1,19 @@
 #pragma once
 #include <QObject>
-#include <QOpenGLFunctions_3_3_Core>
+#include "glstats.h"
 #include <QOpenGLBuffer>
 #include <QOpenGLVertexArrayObject>
 #include <QVector3D>
 #include <QVector2D>
 #include <QOpenGLShaderProgram>
 #include <vector>
+#include "sceneuniforms.h"
 
 /*
  * Classe Sword :
  * Gère la création, la géométrie et le rendu OpenGL d’un sabre.
  */
-class Sword : public QObject, protected QOpenGLFunctions_3_3_Core {
+class Sword : public QObject, protected glstats::CountingFunctions {
     Q_OBJECT
 public:
     //--- Structure de vertex utilisée pour le sabre ---
@@ -28,9 +29,13 @@ public:
 
     //--- Initialisation et rendu ---
     void initialize();  // Configure VAO, VBO et construit la géométrie
-    void render(QOpenGLShaderProgram& shader,
-                const QMatrix4x4& view,
-                const QMatrix4x4& proj);  // Dessine le sabre selon les matrices
+    // Dessine le sabre ; shader de scène déjà lié, vue/proj fournies par l’UBO
+    void render(const ShaderLocations& loc);
+
+    //--- Lame pour les collisions (repère du sabre, le long de +y) ---
+    static constexpr float kBladeBase      = 0.25f;  // Haut de la poignée
+    static constexpr float kBladeTip       = 1.45f;  // Pointe (lame 1.0 + pointe 0.2)
+    static constexpr float kBladeHalfWidth = 0.05f;  // Demi-largeur de la lame
 
     //--- Transformation dans le monde ---
     // Définit la position globale du sabre
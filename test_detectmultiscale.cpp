@@ -1,18 +1,46 @@
 #include "test_detectmultiscale.h"
+#include "perfprobe.h"
+#include "alloccounter.h"
 #include <opencv2/opencv.hpp>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/objdetect.hpp>
+#include <chrono>
+#include <cmath>
 #include <stdexcept>
+#include <iostream>
 
 using namespace cv;
 using namespace std;
 
+namespace {
+
+/*
+ * En-tête continu size×type sur storage (octets). Un stockage trop petit est porté
+ * d’un coup à capacity (pleine frame) : les ROI, dont la taille varie d’une frame à
+ * l’autre, ne provoquent plus de réallocation ensuite.
+ * L’en-tête n’est pas une sous-matrice : filtres et bordures d’OpenCV ne lisent rien
+ * autour, comme sur un Mat indépendant.
+ */
+Mat reuseBuffer(Mat& storage, Size size, int type, Size capacity)
+{
+    const size_t bytes = size_t(size.area()) * CV_ELEM_SIZE(type);
+    if (storage.total() < bytes)
+        storage.create(1, int(max(bytes, size_t(capacity.area()) * CV_ELEM_SIZE(type))), CV_8U);
+    return Mat(size, type, storage.data);
+}
+
+} // namespace
+
 PalmDetector::PalmDetector(int deviceId, const std::string& cascadePath)
+    : PalmDetector(make_unique<CameraFrameSource>(deviceId), cascadePath)
 {
+}
 
-    cap.open(deviceId);
-    if (!cap.isOpened()) {
-        throw runtime_error("Error: Unable to open camera device");
+PalmDetector::PalmDetector(std::unique_ptr<FrameSource> src, const std::string& cascadePath)
+    : source(std::move(src))
+{
+    if (!source) {
+        throw runtime_error("Error: No frame source");
     }
 
     if (!palmCascade.load(cascadePath)) {
@@ -22,43 +50,114 @@ PalmDetector::PalmDetector(int deviceId, const std::string& cascadePath)
 
     claheCr = createCLAHE(2.0, Size(8,8));
     claheCb = createCLAHE(2.0, Size(8,8));
+    morphKernel = getStructuringElement(MORPH_ELLIPSE, Size(5,5));
+    contours.reserve(64);
+    approx.reserve(64);
+    cascadePalms.reserve(16);
+}
+
+PalmDetector::~PalmDetector()
+{
+    {
+        lock_guard<mutex> lock(cascadeMutex);
+        cascadeStop = true;
+    }
+    cascadeJobCv.notify_all();
+    if (cascadeThread.joinable())
+        cascadeThread.join();
 }
 
 bool PalmDetector::getAnnotatedFrame(cv::Mat& frame, std::vector<cv::Point>& centers)
 {
+    if (!grabFrame(frame)) return false;
+    detect(frame, centers);
+    drawAnnotations(frame);
+    return true;
+}
+
+bool PalmDetector::grabFrame(cv::Mat& frame)
+{
+    const perf::ScopedTimer timer(perf::Capture);
+    return source->grab(frame) && !frame.empty();
+}
 
-    cap >> frame;
-    if (frame.empty()) return false;
+void PalmDetector::segmentSkin(const cv::Mat& bgr, cv::Mat& skinMask)
+{
+    // Noyau fusionné : pas de ycrcb / split / merge intermédiaires
+    skinMask.create(bgr.size(), CV_8U);   // No-op sur un en-tête déjà dimensionné
+    if (!claheEnabled) {
+        skin::segmentBgr(bgr.data, bgr.step, skinMask.data, skinMask.step,
+                         bgr.cols, bgr.rows, skinThresholds);
+    } else {
+        crPlane = reuseBuffer(crStore, bgr.size(), CV_8U, planeCapacity);
+        cbPlane = reuseBuffer(cbStore, bgr.size(), CV_8U, planeCapacity);
+        skin::bgrToCrCb(bgr.data, bgr.step, crPlane.data, crPlane.step,
+                        cbPlane.data, cbPlane.step, bgr.cols, bgr.rows);
+        {
+            const AllocExempt opencvInternal;   // Corps parallèles + tampon d’interpolation
+            claheCr->apply(crPlane, crPlane);
+            claheCb->apply(cbPlane, cbPlane);
+        }
+        skin::thresholdCrCb(crPlane.data, crPlane.step, cbPlane.data, cbPlane.step,
+                            skinMask.data, skinMask.step, bgr.cols, bgr.rows, skinThresholds);
+    }
 
+#ifdef SDD_VERIFY_SKIN_KERNEL
+    Mat reference;
+    segmentSkinReference(bgr, reference);
+    if (countNonZero(reference != skinMask) != 0)
+        cerr << "PalmDetector: skin kernel (" << skin::isaName(skin::Isa::Auto)
+             << ") differs from the OpenCV chain" << endl;
+#endif
+
+
+    // Ouverture puis fermeture, via un tampon persistant (morphologyEx alloue le sien)
+    morphScratch = reuseBuffer(morphStore, bgr.size(), CV_8U, planeCapacity);
+    const AllocExempt opencvInternal;   // FilterEngine recréé à chaque appel
+    erode (skinMask, morphScratch, morphKernel);
+    dilate(morphScratch, skinMask, morphKernel);
+    dilate(skinMask, morphScratch, morphKernel);
+    erode (morphScratch, skinMask, morphKernel);
+}
 
+void PalmDetector::segmentSkinReference(const cv::Mat& bgr, cv::Mat& skinMask)
+{
     Mat ycrcb;
-    cvtColor(frame, ycrcb, COLOR_BGR2YCrCb);
+    cvtColor(bgr, ycrcb, COLOR_BGR2YCrCb);
     vector<Mat> ch;
     split(ycrcb, ch);
-    claheCr->apply(ch[1], ch[1]);
-    claheCb->apply(ch[2], ch[2]);
+    if (claheEnabled) {
+        claheCr->apply(ch[1], ch[1]);
+        claheCb->apply(ch[2], ch[2]);
+    }
     merge(ch, ycrcb);
 
-    Mat skinMask;
-    inRange(ycrcb, Scalar(0, 125, 70), Scalar(255, 180, 140), skinMask);
-
-
-    Mat kernel = getStructuringElement(MORPH_ELLIPSE, Size(5,5));
-    morphologyEx(skinMask, skinMask, MORPH_OPEN, kernel);
-    morphologyEx(skinMask, skinMask, MORPH_CLOSE, kernel);
+    inRange(ycrcb,
+            Scalar(0,   skinThresholds.crMin, skinThresholds.cbMin),
+            Scalar(255, skinThresholds.crMax, skinThresholds.cbMax),
+            skinMask);
+}
 
+bool PalmDetector::findPalmContour(const cv::Mat& skinMask, double scale, PalmCandidate& out)
+{
+    {
+        const AllocExempt opencvInternal;   // Copie bordée + stockage de chaînes
+        findContours(skinMask, contours, RETR_EXTERNAL, CHAIN_APPROX_SIMPLE);
+    }
 
-    vector<vector<Point>> contours;
-    findContours(skinMask, contours, RETR_EXTERNAL, CHAIN_APPROX_SIMPLE);
+    // Seuils exprimés à pleine résolution, ramenés à l’échelle de travail
+    const double minArea   = 5000 * scale * scale;
+    const double minRadius = 15 * scale;
 
-    bool foundPalm = false;
     for (auto& cnt : contours) {
         double area = contourArea(cnt);
-        if (area < 5000) continue;
+        if (area < minArea) continue;
 
 
-        vector<Point> approx;
-        approxPolyDP(cnt, approx, arcLength(cnt, true)*0.02, true);
+        {
+            const AllocExempt opencvInternal;   // AutoBuffer au-delà de la pile
+            approxPolyDP(cnt, approx, arcLength(cnt, true)*0.02, true);
+        }
         if (approx.size() == 4 && isContourConvex(approx)) {
 
             Rect br = boundingRect(approx);
@@ -66,54 +165,306 @@ bool PalmDetector::getAnnotatedFrame(cv::Mat& frame, std::vector<cv::Point>& cen
             if (ratio < 0.5 || ratio > 2.0) continue;
 
 
-            Mat roiMask = Mat::zeros(skinMask.size(), CV_8U);
-            drawContours(roiMask, vector<vector<Point>>{approx}, 0, Scalar(255), FILLED);
-
-
-            Mat dist;
-            distanceTransform(roiMask, dist, DIST_L2, 5);
+            polyMask    = reuseBuffer(polyStore, skinMask.size(), CV_8U, planeCapacity);
+            distScratch = reuseBuffer(distStore, skinMask.size(), CV_32F, planeCapacity);
+            polyMask.setTo(Scalar(0));
+            {
+                const AllocExempt opencvInternal;   // Sommets recopiés + image bordée
+                fillConvexPoly(polyMask, approx, Scalar(255));
+                distanceTransform(polyMask, distScratch, DIST_L2, 5);
+            }
             double maxVal;
             Point maxLoc;
-            minMaxLoc(dist, nullptr, &maxVal, nullptr, &maxLoc);
-            if (maxVal < 15) continue;
+            minMaxLoc(distScratch, nullptr, &maxVal, nullptr, &maxLoc);
+            if (maxVal < minRadius) continue;
 
-            centers.push_back(maxLoc);
+            out.box    = br;
+            out.center = maxLoc;
+            out.radius = maxVal;
+            return true;
+        }
+    }
+    return false;
+}
 
-            rectangle(frame, br, Scalar(255,0,0), 2);
-            circle(frame, maxLoc, int(maxVal*0.5), Scalar(0,255,0), 2);
-            foundPalm = true;
-            break;
+cv::Point PalmDetector::refineCenter(const cv::Mat& frame, const cv::Rect& box, cv::Point coarse)
+{
+    // Fenêtre pleine résolution autour de la boîte, marge = un pixel de travail
+    const int pad = int(std::ceil(1.0 / processingScale)) + 2;
+    const Rect window = Rect(box.x - pad, box.y - pad, box.width + 2*pad, box.height + 2*pad)
+                      & Rect(0, 0, frame.cols, frame.rows);
+    if (window.area() == 0)
+        return coarse;
+
+    refineMask  = reuseBuffer(refineStore, window.size(), CV_8U, planeCapacity);
+    segmentSkin(frame(window), refineMask);
+    distScratch = reuseBuffer(distStore, window.size(), CV_32F, planeCapacity);
+    {
+        const AllocExempt opencvInternal;
+        distanceTransform(refineMask, distScratch, DIST_L2, 5);
+    }
+    double maxVal;
+    Point maxLoc;
+    minMaxLoc(distScratch, nullptr, &maxVal, nullptr, &maxLoc);
+    return maxVal > 0 ? window.tl() + maxLoc : coarse;
+}
+
+void PalmDetector::detect(const cv::Mat& frame, std::vector<cv::Point>& centers)
+{
+    const perf::ScopedTimer timer(perf::Detect);
+    ++frameCounter;
+    overlay       = Overlay();
+    planeCapacity = frame.size();   // Toute ROI (travail ou pleine rés.) y tient
+    const Rect frameRect(0, 0, frame.cols, frame.rows);
+
+    // Image de travail : frame réduite à processingScale (INTER_AREA)
+    const double s = processingScale;
+    const bool scaled = s < 1.0;
+    if (scaled) {
+        const AllocExempt opencvInternal;   // Tables de coefficients INTER_AREA
+        resize(frame, scaledFrame, Size(), s, s, INTER_AREA);
+    }
+    const Mat& work = scaled ? scaledFrame : frame;
+    const Rect workRect(0, 0, work.cols, work.rows);
+
+    auto toWork = [&](const Rect& r) {
+        return Rect(cvFloor(r.x * s), cvFloor(r.y * s),
+                    cvCeil(r.width * s), cvCeil(r.height * s)) & workRect;
+    };
+    auto toFull = [&](const Rect& r) {
+        return Rect(cvRound(r.x / s), cvRound(r.y / s),
+                    cvRound(r.width / s), cvRound(r.height / s)) & frameRect;
+    };
+    auto toFullPt = [&](Point p) {
+        return Point(cvRound((p.x + 0.5) / s - 0.5), cvRound((p.y + 0.5) / s - 0.5));
+    };
+
+    // Mode suivi : ROI élargie autour de la dernière paume, réacquisition
+    // plein cadre périodique ou dès que la paume est perdue.
+    Rect roi = frameRect;
+    bool tracking = trackingEnabled && trackBox.area() > 0
+                 && framesSinceFullFrame < reacquireInterval;
+    if (tracking) {
+        const int padX = int(trackBox.width  * roiPadding);
+        const int padY = int(trackBox.height * roiPadding);
+        roi = Rect(trackBox.x - padX, trackBox.y - padY,
+                   trackBox.width + 2*padX, trackBox.height + 2*padY) & frameRect;
+        tracking = toWork(roi).area() > 0;
+    }
+
+    Rect workRoi = tracking ? toWork(roi) : workRect;
+    PalmCandidate palm;
+    bool foundPalm = false;
+    workMask = reuseBuffer(workMaskStore, workRoi.size(), CV_8U, planeCapacity);
+    { const perf::ScopedTimer t(perf::DetectSegment);  segmentSkin(work(workRoi), workMask); }
+    { const perf::ScopedTimer t(perf::DetectContours); foundPalm = findPalmContour(workMask, s, palm); }
+
+    if (!foundPalm && tracking) {
+        tracking = false;
+        roi      = frameRect;
+        workRoi  = workRect;
+        workMask = reuseBuffer(workMaskStore, workRoi.size(), CV_8U, planeCapacity);
+        { const perf::ScopedTimer t(perf::DetectSegment);  segmentSkin(work, workMask); }
+        { const perf::ScopedTimer t(perf::DetectContours); foundPalm = findPalmContour(workMask, s, palm); }
+    }
+
+    mode = tracking ? DetectionMode::Tracking : DetectionMode::FullFrame;
+    framesSinceFullFrame = tracking ? framesSinceFullFrame + 1 : 0;
+
+    if (foundPalm) {
+        const Rect  br     = toFull(palm.box + workRoi.tl());
+        Point       center = toFullPt(palm.center + workRoi.tl());
+        if (scaled) {
+            const perf::ScopedTimer t(perf::DetectContours);
+            center = refineCenter(frame, br, center);
         }
+        centers.push_back(center);
+        trackBox = br;
+        recordMotion(center, br);
+
+        overlay.box         = br;
+        overlay.boxColor    = Scalar(255,0,0);
+        overlay.center      = center;
+        overlay.radius      = int(palm.radius / s * 0.5);
+        overlay.circleColor = Scalar(0,255,0);
     }
 
 
     if (!foundPalm) {
-        vector<Rect> palms;
-        palmCascade.detectMultiScale(frame, palms, 1.1, 5, 0, Size(80,80));
-        if (!palms.empty()) {
+        const perf::ScopedTimer t(perf::DetectCascade);
+        // Cascade asynchrone : on prend un résultat arrivé entre-temps, sinon on lance
+        // une recherche dans la fenêtre prédite et on l’attend au plus cascadeBudgetMs.
+        vector<Rect>& palms = cascadePalms;
+        palms.clear();
+        bool got = takeCascadeResult(palms, 0.0);
+        if ((!got || palms.empty()) && submitCascade(work, predictSearchWindow(workRect, s), s)) {
+            palms.clear();
+            got = takeCascadeResult(palms, asyncCascade ? cascadeBudgetMs : -1.0);
+        }
+        if (got && !palms.empty()) {
 
-            Rect best = *max_element(palms.begin(), palms.end(), [](auto&a,auto&b){return a.area()<b.area();});
+            Rect best = *max_element(palms.begin(), palms.end(), [](auto&a,auto&b){return a.area()<b.area();}) & frameRect;
             Point centerPt(best.x + best.width/2, best.y + best.height/2);
             centers.push_back(centerPt);
-
-            rectangle(frame, best, Scalar(0,0,255), 2);
-            circle(frame, centerPt, 10, Scalar(0,255,255), 2);
+            trackBox = best;
+            recordMotion(centerPt, best);
+
+            overlay.box         = best;
+            overlay.boxColor    = Scalar(0,0,255);
+            overlay.center      = centerPt;
+            overlay.radius      = 10;
+            overlay.circleColor = Scalar(0,255,255);
             foundPalm = true;
         }
     }
 
 
     if (!foundPalm) {
-        Mat dist;
-        distanceTransform(skinMask, dist, DIST_L2, 5);
+        const perf::ScopedTimer t(perf::DetectFallback);
+        distScratch = reuseBuffer(distStore, workMask.size(), CV_32F, planeCapacity);
+        {
+            const AllocExempt opencvInternal;
+            distanceTransform(workMask, distScratch, DIST_L2, 5);
+        }
         double maxVal;
         Point maxLoc;
-        minMaxLoc(dist, nullptr, &maxVal, nullptr, &maxLoc);
-        if (maxVal >= 10) {
-            centers.push_back(maxLoc);
-            circle(frame, maxLoc, int(maxVal*0.5), Scalar(255,255,0), 2);
+        minMaxLoc(distScratch, nullptr, &maxVal, nullptr, &maxLoc);
+        if (maxVal >= 10 * s) {
+            const Point center = toFullPt(maxLoc + workRoi.tl());
+            centers.push_back(center);
+            overlay.center      = center;
+            overlay.radius      = int(maxVal / s * 0.5);
+            overlay.circleColor = Scalar(255,255,0);
         }
+        // Pas de boîte fiable : prochaine frame en plein cadre
+        trackBox = Rect();
     }
 
+    if (tracking)
+        overlay.roi = roi;
+}
+
+void PalmDetector::drawAnnotations(cv::Mat& frame) const
+{
+    if (overlay.box.area() > 0)
+        rectangle(frame, overlay.box, overlay.boxColor, 2);
+    if (overlay.radius > 0)
+        circle(frame, overlay.center, overlay.radius, overlay.circleColor, 2);
+    if (overlay.roi.area() > 0)
+        rectangle(frame, overlay.roi, Scalar(128,128,128), 1);
+}
+
+//=== Cascade asynchrone =========================================================
+
+void PalmDetector::recordMotion(cv::Point center, const cv::Rect& box)
+{
+    motion[0]    = motion[1];
+    motion[1]    = { Point2f(center), frameCounter };
+    motionCount  = min(motionCount + 1, 2);
+    motionBox    = box;
+}
+
+cv::Rect PalmDetector::predictSearchWindow(const cv::Rect& workRect, double scale) const
+{
+    // Pas d’historique récent : recherche sur toute l’image de travail
+    if (motionCount == 0 || frameCounter - motion[1].frame > kMaxPredictionAge)
+        return workRect;
+
+    const double elapsed = double(frameCounter - motion[1].frame);
+    Point2f velocity(0.f, 0.f);
+    if (motionCount == 2 && motion[1].frame > motion[0].frame)
+        velocity = (motion[1].center - motion[0].center) / float(motion[1].frame - motion[0].frame);
+
+    // Centre extrapolé, fenêtre = boîte connue élargie + déplacement possible
+    const Point2f predicted = motion[1].center + velocity * float(elapsed);
+    const double  half      = max(motionBox.width, motionBox.height) * 1.5
+                            + norm(velocity) * elapsed;
+    const Rect full(cvFloor(predicted.x - half), cvFloor(predicted.y - half),
+                    cvCeil(2 * half), cvCeil(2 * half));
+    const Rect window = Rect(cvFloor(full.x * scale), cvFloor(full.y * scale),
+                             cvCeil(full.width * scale), cvCeil(full.height * scale)) & workRect;
+
+    const int minSide = cvRound(80 * scale);
+    if (window.width < minSide || window.height < minSide)
+        return workRect;
+    return window;
+}
+
+bool PalmDetector::submitCascade(const cv::Mat& work, const cv::Rect& window, double scale)
+{
+    lock_guard<mutex> lock(cascadeMutex);
+    if (cascadeBusy)
+        return false;
+
+    if (!cascadeThread.joinable())
+        cascadeThread = std::thread(&PalmDetector::cascadeLoop, this);
+
+    // Tampon à la taille de l’image de travail, la fenêtre n’en est qu’une vue :
+    // pas de réallocation quand la taille de la fenêtre prédite change
+    cascadeBuffer.create(work.size(), work.type());
+    cascadeJob.image = cascadeBuffer(Rect(Point(0, 0), window.size()));
+    work(window).copyTo(cascadeJob.image);
+    cascadeJob.offset = window.tl();
+    cascadeJob.scale  = scale;
+    cascadeJob.frame  = frameCounter;
+    cascadeBusy       = true;
+    cascadeJobPending = true;
+    cascadeJobCv.notify_one();
     return true;
 }
+
+bool PalmDetector::takeCascadeResult(std::vector<cv::Rect>& palms, double waitMs)
+{
+    unique_lock<mutex> lock(cascadeMutex);
+    if (!cascadeResultReady) {
+        if (waitMs == 0.0 || !cascadeBusy)
+            return false;
+        auto ready = [this] { return cascadeResultReady; };
+        if (waitMs < 0.0)
+            cascadeDoneCv.wait(lock, ready);
+        else if (!cascadeDoneCv.wait_for(lock, chrono::duration<double, milli>(waitMs), ready))
+            return false;
+    }
+    cascadeResultReady = false;
+
+    // Résultat trop ancien : la main a bougé depuis, on l’ignore
+    if (frameCounter - cascadeResult.frame > kMaxCascadeAge)
+        return false;
+    palms.insert(palms.end(), cascadeResult.palms.begin(), cascadeResult.palms.end());
+    return true;
+}
+
+void PalmDetector::cascadeLoop()
+{
+    trace::setThreadName("cascade");
+    unique_lock<mutex> lock(cascadeMutex);
+    while (true) {
+        cascadeJobCv.wait(lock, [this] { return cascadeStop || cascadeJobPending; });
+        if (cascadeStop)
+            return;
+        cascadeJobPending = false;
+
+        // Le thread de détection ne touche plus au job tant que cascadeBusy est vrai
+        const Mat       image  = cascadeJob.image;
+        const Point     offset = cascadeJob.offset;
+        const double    scale  = cascadeJob.scale;
+        const uint64_t  frame  = cascadeJob.frame;
+        lock.unlock();
+
+        vector<Rect> palms;
+        const int minSide = cvRound(80 * scale);
+        palmCascade.detectMultiScale(image, palms, 1.1, 5, 0, Size(minSide, minSide));
+        for (Rect& r : palms) {
+            r += offset;
+            r = Rect(cvRound(r.x / scale), cvRound(r.y / scale),
+                     cvRound(r.width / scale), cvRound(r.height / scale));
+        }
+
+        lock.lock();
+        cascadeResult.palms = std::move(palms);
+        cascadeResult.frame = frame;
+        cascadeResultReady  = true;
+        cascadeBusy         = false;
+        cascadeDoneCv.notify_all();
+    }
+}
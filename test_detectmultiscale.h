@@ -10,17 +10,36 @@
 #include <opencv2/objdetect.hpp>
 #include <opencv2/core/types.hpp>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 #include <stdexcept>
 
+#include "framesource.h"
+#include "skinsegment.h"
+
+/*
+ * Mode de la dernière détection :
+ * - FullFrame : segmentation sur toute l’image (acquisition / réacquisition)
+ * - Tracking  : segmentation limitée à une ROI autour de la paume précédente
+ */
+enum class DetectionMode { FullFrame, Tracking };
+
 /*
  * Classe PalmDetector :
- * - Capture le flux vidéo depuis la cam
+ * - Lit les frames depuis une FrameSource (caméra, vidéo, synthétique)
  * - Détecte le centre de la paume (contours + fallback cascade)
  */
 class PalmDetector {
 public:
+    /// Cascade palm livré avec le projet
+    static constexpr const char* kDefaultCascadePath = "C:/Users/khali/dev/sd lakheeer/palm.xml";
+
     /**
      * Initialise la capture et charge le cascade classifier.
      * @param deviceId    index de la caméra OpenCV (ex. 0 pour la webcam)
@@ -30,19 +49,171 @@ public:
     PalmDetector(int deviceId, const std::string& cascadePath);
 
     /**
-     * Récupère une frame, détecte la paume et annote l’image.
+     * Variante avec une source de frames quelconque.
+     * @param source      source possédée par le détecteur
+     * @param cascadePath chemin vers le XML du cascade palm
+     * @throws runtime_error si source nulle ou échec de chargement cascade
+     */
+    PalmDetector(std::unique_ptr<FrameSource> source, const std::string& cascadePath);
+
+    ~PalmDetector();                               // Arrête le thread cascade
+
+    PalmDetector(const PalmDetector&)            = delete;
+    PalmDetector& operator=(const PalmDetector&) = delete;
+
+    /**
+     * Récupère une frame, détecte la paume et annote l’image (detect + drawAnnotations).
      * @param frame   frame BGR en entrée/sortie (dessin rectangles & cercles)
      * @param centers liste des points centraux détectés (coord. pixel)
      * @return true si la frame est capturée et traitée, false sinon
      */
     bool getAnnotatedFrame(cv::Mat& frame, std::vector<cv::Point>& centers);
 
+    /**
+     * Capture seule (bloquante) : utilisée par le thread de capture.
+     * @return false si aucune frame n’a pu être lue
+     */
+    bool grabFrame(cv::Mat& frame);
+
+    /**
+     * Détection seule sur une frame déjà capturée : utilisée par le thread de détection.
+     * Aucune allocation en régime établi hors appels OpenCV exemptés (cf. alloccounter.h).
+     * @param frame   frame BGR (non modifiée : le dessin est dans drawAnnotations)
+     * @param centers centres détectés ajoutés à la liste
+     */
+    void detect(const cv::Mat& frame, std::vector<cv::Point>& centers);
+
+    /**
+     * Dessine sur frame les boîtes / cercles de la dernière détection et la ROI de suivi.
+     * Hors de la frame mesurée : rectangle / circle allouent leurs polylignes.
+     */
+    void drawAnnotations(cv::Mat& frame) const;
+
+    //=== Suivi par région d’intérêt =============================
+    void setTrackingEnabled(bool on)     { trackingEnabled = on; if (!on) trackBox = cv::Rect(); }
+    void setRoiPadding(double fraction)  { roiPadding = fraction; }      ///< marge ROI (fraction de la boîte)
+    void setReacquireInterval(int n)     { reacquireInterval = n; }     ///< frames max entre deux plein cadre
+    DetectionMode lastMode() const       { return mode; }                ///< mode de la dernière détection
+
+    /**
+     * Échelle de traitement : segmentation, contours et cascade tournent sur la frame
+     * réduite (1.0, 0.5, 0.25…), seul le centre final est affiné à pleine résolution.
+     */
+    void   setProcessingScale(double scale) { processingScale = std::clamp(scale, 0.1, 1.0); }
+    double getProcessingScale() const       { return processingScale; }
+
+    void resetTracking()                 { trackBox = cv::Rect(); framesSinceFullFrame = 0; motionCount = 0; }
+
+    /**
+     * Fallback cascade : exécuté sur un thread dédié, dans une fenêtre prédite à partir
+     * du mouvement récent. detect() n’attend le résultat qu’au plus budgetMs ; un résultat
+     * plus tardif est fusionné dans le suivi à la frame suivante.
+     * async = false : attente complète (comportement synchrone d’origine).
+     */
+    void setAsyncCascade(bool async)     { asyncCascade = async; }
+    void setCascadeBudgetMs(double ms)   { cascadeBudgetMs = ms; }
+
+    //=== Segmentation peau ======================================
+    void setClaheEnabled(bool on)        { claheEnabled = on; }          ///< CLAHE sur Cr/Cb avant seuillage
+
+    /**
+     * Chaîne OpenCV d’origine (cvtColor + split + CLAHE + merge + inRange), sans morphologie.
+     * Référence bit-exacte du noyau fusionné (cf. SDD_VERIFY_SKIN_KERNEL).
+     */
+    void segmentSkinReference(const cv::Mat& bgr, cv::Mat& skinMask);
+
 private:
+    void segmentSkin(const cv::Mat& bgr, cv::Mat& skinMask);             ///< noyau peau (+ CLAHE) + morpho
+    /// Paume trouvée par l’heuristique contours (coord. de l’image de travail)
+    struct PalmCandidate {
+        cv::Rect  box;
+        cv::Point center;
+        double    radius = 0.0;
+    };
+    bool findPalmContour(const cv::Mat& skinMask, double scale, PalmCandidate& out); ///< heuristique contours
+    cv::Point refineCenter(const cv::Mat& frame, const cv::Rect& box, cv::Point coarse); ///< affinage pleine rés.
+
+    void     recordMotion(cv::Point center, const cv::Rect& box);            ///< historique pour la prédiction
+    cv::Rect predictSearchWindow(const cv::Rect& workRect, double scale) const; ///< fenêtre cascade (coord. travail)
+    bool     submitCascade(const cv::Mat& work, const cv::Rect& window, double scale); ///< false si occupé
+    bool     takeCascadeResult(std::vector<cv::Rect>& palms, double waitMs);   ///< waitMs < 0 : attente complète
+    void     cascadeLoop();                                                    ///< corps du thread cascade
+
+
     //=== Ressources internes OpenCV ============================
-    cv::VideoCapture     cap;          ///< périphérique vidéo
-    cv::CascadeClassifier palmCascade; ///< fallback cascade classifier
+    std::unique_ptr<FrameSource> source; ///< source des frames
+    cv::CascadeClassifier palmCascade; ///< fallback cascade classifier (thread cascade uniquement)
     cv::Ptr<cv::CLAHE>   claheCr;      ///< CLAHE canal Cr
     cv::Ptr<cv::CLAHE>   claheCb;      ///< CLAHE canal Cb
+    bool                 claheEnabled = true;
+    skin::Thresholds     skinThresholds;   ///< Cr [125,180], Cb [70,140]
+    cv::Mat              crPlane;          ///< plan Cr réutilisé (chemin CLAHE)
+    cv::Mat              cbPlane;          ///< plan Cb réutilisé (chemin CLAHE)
+
+    //=== Tampons persistants (aucune allocation en régime établi) ===
+    // Chaque plan est un en-tête continu posé sur son stockage *Store, qui ne grandit
+    // qu’au-delà de la plus grande taille vue : la ROI de suivi change de taille
+    // d’une frame à l’autre sans réallouer.
+    cv::Mat                            workMask;      ///< masque peau de la passe courante
+    cv::Mat                            morphScratch;  ///< intermédiaire érosion/dilatation
+    cv::Mat                            morphKernel;   ///< ellipse 5x5, construite une fois
+    cv::Mat                            polyMask;      ///< quadrilatère paume rempli
+    cv::Mat                            distScratch;   ///< sortie distanceTransform (CV_32F)
+    cv::Mat workMaskStore, morphStore, polyStore, distStore, crStore, cbStore, refineStore;
+    cv::Size                           planeCapacity; ///< taille de la frame : borne de tout plan
+    std::vector<std::vector<cv::Point>> contours;     ///< sortie findContours
+    std::vector<cv::Point>             approx;        ///< polygone approché
+    std::vector<cv::Rect>              cascadePalms;  ///< résultats cascade fusionnés
+
+    //=== Échelle de traitement ==================================
+    double               processingScale = 1.0;
+    cv::Mat              scaledFrame;      ///< frame réduite réutilisée
+    cv::Mat              refineMask;       ///< masque pleine rés. autour de la paume
+
+    //=== Historique de mouvement ================================
+    struct MotionSample { cv::Point2f center; std::uint64_t frame = 0; };
+    static constexpr std::uint64_t kMaxPredictionAge = 15;  ///< frames avant recherche plein cadre
+    std::uint64_t        frameCounter = 0;
+    MotionSample         motion[2];        ///< deux derniers centres connus
+    int                  motionCount  = 0;
+    cv::Rect             motionBox;        ///< dernière boîte connue (pleine rés.)
+
+    //=== Cascade asynchrone =====================================
+    struct CascadeJob    { cv::Mat image; cv::Point offset; double scale = 1.0; std::uint64_t frame = 0; };
+    struct CascadeResult { std::vector<cv::Rect> palms; std::uint64_t frame = 0; };
+    static constexpr std::uint64_t kMaxCascadeAge = 5;      ///< frames max entre requête et fusion
+    bool                    asyncCascade    = true;
+    double                  cascadeBudgetMs = 4.0;
+    std::thread             cascadeThread;  ///< démarré au premier besoin
+    std::mutex              cascadeMutex;
+    std::condition_variable cascadeJobCv;   ///< réveille le thread cascade
+    std::condition_variable cascadeDoneCv;  ///< signale un résultat
+    CascadeJob              cascadeJob;
+    cv::Mat                 cascadeBuffer;  ///< stockage de cascadeJob.image (taille de travail)
+    CascadeResult           cascadeResult;
+    bool                    cascadeBusy        = false;
+    bool                    cascadeJobPending  = false;
+    bool                    cascadeResultReady = false;
+    bool                    cascadeStop        = false;
+
+    //=== Annotations de la dernière détection (cf. drawAnnotations) ===
+    struct Overlay {
+        cv::Rect   box;            ///< vide = pas de boîte
+        cv::Scalar boxColor;
+        cv::Point  center;
+        int        radius = 0;     ///< 0 = pas de cercle
+        cv::Scalar circleColor;
+        cv::Rect   roi;            ///< ROI de suivi (vide = plein cadre)
+    };
+    Overlay       overlay;
+
+    //=== État du suivi ==========================================
+    bool          trackingEnabled      = true;
+    double        roiPadding           = 0.5;   ///< ROI = boîte + 50 % de chaque côté
+    int           reacquireInterval    = 30;    ///< plein cadre au moins 1 frame sur 30
+    int           framesSinceFullFrame = 0;
+    cv::Rect      trackBox;                     ///< dernière boîte paume (vide = perdue)
+    DetectionMode mode = DetectionMode::FullFrame;
 };
 
 #endif // TEST_DETECTMULTISCALE_H
@@ -0,0 +1,129 @@
+// test_allocations : zéro allocation tas par frame en régime établi (SDD_COUNT_ALLOCATIONS).
+//  → PalmDetector::detect sur une source synthétique, à chaque échelle de traitement :
+//    allocations hors portées AllocExempt ≤ alloccount::kSteadyFrameBudget (0).
+//  → Chemin d’affichage du thread GUI : copie de la frame annotée (PalmPipeline) puis
+//    renderPreview dans la QImage réutilisée (MainWindow::updateFrame) : 0, sans exemption.
+// Hors mesure, comme dans l’application : capture (thread de capture) et
+// drawAnnotations (dessin OpenCV).
+// Chauffe = un tour complet de la trajectoire synthétique ; mesure = le tour suivant.
+// Code de sortie : 0 si tout tient dans le budget, 1 sinon.
+
+#include "alloccounter.h"
+#include "framesource.h"
+#include "previewimage.h"
+#include "test_detectmultiscale.h"
+#include <QImage>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+namespace {
+
+constexpr int kPreviewW = 316;   // Zone image de PreviewView (320×240 moins la bordure)
+constexpr int kPreviewH = 236;
+
+struct FrameAllocs {
+    uint64_t detect  = 0;   // detect(), hors AllocExempt
+    uint64_t exempt  = 0;   // detect(), appels OpenCV exemptés (information)
+    uint64_t display = 0;   // copie annotée + aperçu, tout compris
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (!alloccount::enabled()) {
+        printf("FAIL: built without SDD_COUNT_ALLOCATIONS\n");
+        return 1;
+    }
+    alloccount::install();
+
+    const string cascadePath = argc > 1 ? argv[1] : SDD_PALM_CASCADE;
+
+    SyntheticFrameSource::Settings cfg;
+    cfg.fps = 0.0;   // Pas de cadence : seules les allocations comptent ici
+    auto source = make_unique<SyntheticFrameSource>(cfg);
+    // Position fonction de l’index seul : un tour de trajectoire revient au même endroit
+    const int loopFrames = 7 * cfg.framesPerSegment;   // Boucle par défaut à 7 waypoints
+
+    int failures = 0;
+    try {
+        PalmDetector detector(std::move(source), cascadePath);
+        detector.setAsyncCascade(false);   // Cascade synchrone : chemin déterministe
+
+        Mat            frame, annotated;
+        vector<Point>  centers;
+        centers.reserve(8);
+        PreviewScaler  scaler;
+        QImage         preview;
+
+        for (double scale : { 1.0, 0.5, 0.25 }) {
+            detector.setProcessingScale(scale);
+            detector.resetTracking();
+
+            FrameAllocs worst;
+            int detected = 0;
+            for (int i = 0; i < 2 * loopFrames; ++i) {
+                if (!detector.grabFrame(frame)) {
+                    printf("FAIL: synthetic source returned no frame\n");
+                    return 1;
+                }
+                centers.clear();
+
+                FrameAllocs f;
+                {
+                    const AllocScope allocs;
+                    const uint64_t   exempt0 = alloccount::threadExemptCount();
+                    detector.detect(frame, centers);
+                    f.detect = allocs.count();
+                    f.exempt = alloccount::threadExemptCount() - exempt0;
+                }
+                detector.drawAnnotations(frame);
+                {
+                    const AllocScope allocs;
+                    const uint64_t   exempt0 = alloccount::threadExemptCount();
+                    frame.copyTo(annotated);
+                    renderPreview(scaler, annotated, kPreviewW, kPreviewH, preview);
+                    f.display = allocs.count() + (alloccount::threadExemptCount() - exempt0);
+                }
+
+                if (i < loopFrames)
+                    continue;   // Chauffe : buffers, tables, thread cascade
+                detected  += centers.empty() ? 0 : 1;
+                worst.detect  = max(worst.detect,  f.detect);
+                worst.exempt  = max(worst.exempt,  f.exempt);
+                worst.display = max(worst.display, f.display);
+                if (f.detect > alloccount::kSteadyFrameBudget || f.display > 0) {
+                    if (++failures <= 10)
+                        printf("FAIL scale %.2f frame %d: detect %llu (budget %llu), display %llu\n",
+                               scale, i, (unsigned long long)f.detect,
+                               (unsigned long long)alloccount::kSteadyFrameBudget,
+                               (unsigned long long)f.display);
+                }
+            }
+
+            printf("scale %.2f: %d/%d frames detected, per frame max: detect %llu, "
+                   "exempt OpenCV %llu, display %llu\n",
+                   scale, detected, loopFrames, (unsigned long long)worst.detect,
+                   (unsigned long long)worst.exempt, (unsigned long long)worst.display);
+            // Sans paume trouvée, seul le repli serait mesuré : le test ne prouverait rien
+            if (detected < loopFrames / 2) {
+                printf("FAIL scale %.2f: palm detected on too few frames\n", scale);
+                ++failures;
+            }
+        }
+    } catch (const exception& e) {
+        printf("FAIL: %s\n", e.what());
+        return 1;
+    }
+
+    if (failures > 0) {
+        printf("%d failure(s)\n", failures);
+        return 1;
+    }
+    printf("OK: no steady-state heap allocation in detect() or the display path\n");
+    return 0;
+}
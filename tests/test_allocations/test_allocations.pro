@@ -0,0 +1,53 @@
+#-------------------------------------------------
+# Test : aucune allocation tas par frame en régime établi, pour PalmDetector::detect
+# (hors appels OpenCV exemptés, cf. alloccounter.h) et pour le chemin d’affichage
+# (copie annotée + aperçu QImage). Source synthétique, sans caméra ni fenêtre.
+# Code de sortie non nul en cas de dépassement : qmake && make && ./test_allocations
+#-------------------------------------------------
+
+QT       = core gui
+CONFIG  += c++17 console
+CONFIG  -= app_bundle
+
+TEMPLATE = app
+TARGET   = test_allocations
+
+INCLUDEPATH += ../..
+
+# Compteur actif ; cascade du dépôt par défaut (premier argument pour en choisir un autre)
+DEFINES += SDD_COUNT_ALLOCATIONS \
+           SDD_PALM_CASCADE=\\\"$$PWD/../../palm.xml\\\"
+
+SOURCES += \
+    main.cpp \
+    ../../alloccounter.cpp \
+    ../../framesource.cpp \
+    ../../perfprobe.cpp \
+    ../../previewscaler.cpp \
+    ../../skinsegment.cpp \
+    ../../test_detectmultiscale.cpp \
+    ../../tracer.cpp
+
+HEADERS += \
+    ../../alloccounter.h \
+    ../../framesource.h \
+    ../../perfprobe.h \
+    ../../previewimage.h \
+    ../../previewscaler.h \
+    ../../skinsegment.h \
+    ../../test_detectmultiscale.h \
+    ../../tracer.h
+
+#----- OpenCV : même installation que sdd.pro sous Windows, pkg-config ailleurs -----
+win32 {
+    OPENCV_DIR = C:/opencv/opencv-4.10.0/build/install
+    INCLUDEPATH += $$OPENCV_DIR/include
+    LIBS += -L$$OPENCV_DIR/x64/mingw/lib \
+            -lopencv_core4100 \
+            -lopencv_imgproc4100 \
+            -lopencv_videoio4100 \
+            -lopencv_objdetect4100
+} else {
+    CONFIG    += link_pkgconfig
+    PKGCONFIG += opencv4
+}
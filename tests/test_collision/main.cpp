@@ -0,0 +1,235 @@
+// test_collision : broadphase et narrowphase des coupes (broadphase.h), sans Qt.
+//  → UniformGrid::querySweptSegment : sur 5000 projectiles tirés au hasard (dans et hors
+//    des bornes de la salle, pas variés), tout projectile que la narrowphase toucherait
+//    par force brute est parmi les candidats, sans doublon. Même grille, même lame et
+//    même seuil (rayon + demi-largeur) que GameScene::simulateStep.
+//  → Cas limites de la lame : fruit juste au-dessus de la pointe, juste sous la base,
+//    à une frontière de cellule.
+//  → segmentSegmentDistance : 20000 paires aléatoires (segments dégénérés et parallèles
+//    compris) ; jamais au-dessus du minimum échantillonné, et au plus à l’erreur
+//    d’échantillonnage en dessous.
+// Code de sortie : 0 si tout concorde, 1 sinon.
+
+#include "broadphase.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace std;
+using Vec3 = ProjectileSim::Vec3;
+
+namespace {
+
+// Lame du sabre dans son repère (cf. Sword::kBlade*)
+constexpr float kBladeBase      = 0.25f;
+constexpr float kBladeTip       = 1.45f;
+constexpr float kBladeHalfWidth = 0.05f;
+
+constexpr int kMaxReports = 10;   // Écarts détaillés avant de se taire
+int s_failures = 0;
+
+mt19937 s_rng(1234);
+
+float uniform(float lo, float hi)
+{
+    return uniform_real_distribution<float>(lo, hi)(s_rng);
+}
+
+Vec3 randomPoint(const Vec3& lo, const Vec3& hi)
+{
+    return { uniform(lo.x, hi.x), uniform(lo.y, hi.y), uniform(lo.z, hi.z) };
+}
+
+Vec3 add(const Vec3& a, const Vec3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+Vec3 sub(const Vec3& a, const Vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+Vec3 lerp(const Vec3& a, const Vec3& b, float t)
+{
+    return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t };
+}
+float length(const Vec3& v) { return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z); }
+
+// Mêmes bornes et taille de cellule que GameScene::m_grid
+UniformGrid makeGrid()
+{
+    return UniformGrid({ -5.f, 0.f, -5.f }, { 5.f, 5.f, 12.f }, 1.f);
+}
+
+// Narrowphase de GameScene::simulateStep : lame fixe, projectile relatif au sabre
+bool bladeHits(const ProjectileSim& sim, int i, const Vec3& sword0, const Vec3& sword1)
+{
+    const ProjectileSim::Arrays& a = sim.data();
+    const Vec3 prev{ a.prevX[i], a.prevY[i], a.prevZ[i] };
+    const Vec3 pos { a.px[i],    a.py[i],    a.pz[i] };
+    return segmentSegmentDistance(sub(prev, sword0), sub(pos, sword1),
+                                  { 0.f, kBladeBase, 0.f }, { 0.f, kBladeTip, 0.f })
+           < 0.5f * a.size[i] + kBladeHalfWidth;
+}
+
+// Candidats de la grille pour la lame balayée de sword0 à sword1
+void queryBlade(const UniformGrid& grid, const Vec3& sword0, const Vec3& sword1, vector<int>& out)
+{
+    const Vec3 base{ 0.f, kBladeBase, 0.f }, tip{ 0.f, kBladeTip, 0.f };
+    grid.querySweptSegment(add(sword0, base), add(sword0, tip), add(sword1, base), add(sword1, tip),
+                           kBladeHalfWidth, out);
+}
+
+// Tout projectile actif touché par force brute doit être candidat, chacun une fois
+void checkBlade(const UniformGrid& grid, const ProjectileSim& sim, const Vec3& sword0,
+                const Vec3& sword1, const char* what, int& hits)
+{
+    vector<int> candidates;
+    queryBlade(grid, sword0, sword1, candidates);
+
+    vector<char> seen(sim.size(), 0);
+    for (int i : candidates) {
+        if (i < 0 || i >= int(sim.size()) || seen[i]++ || !sim.isActive(i)) {
+            if (++s_failures <= kMaxReports)
+                printf("FAIL %s: candidate %d duplicated, out of range or inactive\n", what, i);
+        }
+    }
+
+    for (int i = 0; i < int(sim.size()); ++i) {
+        if (!sim.isActive(i) || !bladeHits(sim, i, sword0, sword1))
+            continue;
+        ++hits;
+        if (!seen[i] && ++s_failures <= kMaxReports)
+            printf("FAIL %s: projectile %d hit by the blade but not returned by the grid\n", what, i);
+    }
+}
+
+// 5000 projectiles à chaque tour : tirs balistiques ou vitesses imposées, puis un
+// pas de durée variable (déplacement du dernier pas non nul, certains désactivés)
+void testGridAgainstBruteForce()
+{
+    constexpr int kRounds      = 40;
+    constexpr int kProjectiles = 5000;
+    constexpr int kSwords      = 50;   // Lames testées par tour
+
+    UniformGrid   grid = makeGrid();
+    ProjectileSim sim;
+    int hits = 0, queries = 0;
+
+    for (int round = 0; round < kRounds; ++round) {
+        sim.clear();
+        sim.resize(kProjectiles);
+        for (int i = 0; i < kProjectiles; ++i) {
+            ProjectileSim::Launch l;
+            l.shape    = i % 4;
+            l.start    = randomPoint({ -6.f, -0.5f, -6.f }, { 6.f, 6.f, 13.f });   // Déborde des bornes
+            l.velocity = randomPoint({ -8.f, -8.f, -8.f }, { 8.f, 8.f, 15.f });
+            l.size     = uniform(0.2f, 1.2f);
+            sim.launch(i, l);
+        }
+        sim.step(uniform(1.f / 240.f, 1.f / 20.f));
+        grid.build(sim);
+
+        for (int k = 0; k < kSwords; ++k) {
+            // Sabre immobile, lent ou en coup rapide (jusqu’à plusieurs mètres par pas)
+            const Vec3 sword0 = randomPoint({ -5.f, -1.f, -5.f }, { 5.f, 4.f, 12.f });
+            const float reach = k % 3 == 0 ? 0.f : (k % 3 == 1 ? 0.2f : 3.f);
+            const Vec3 sword1 = add(sword0, randomPoint({ -reach, -reach, -reach }, { reach, reach, reach }));
+            checkBlade(grid, sim, sword0, sword1, "grid vs brute force", hits);
+            ++queries;
+        }
+    }
+
+    printf("grid: %d queries over %d projectiles, %d brute-force hits\n", queries, kProjectiles, hits);
+    // Aucun contact : le test n’aurait rien vérifié
+    if (hits == 0) {
+        printf("FAIL grid: no brute-force hit, the scenario does not exercise the grid\n");
+        ++s_failures;
+    }
+}
+
+// Fruit immobile juste au-dessus de la pointe ou juste sous la base : touché par la
+// narrowphase grâce à la demi-largeur, il doit aussi sortir de la broadphase. Le sabre
+// est placé pour que la boîte sans demi-largeur s’arrête à 1 cm d’une frontière de
+// cellule que le fruit a franchie : l’arrondi aux cellules ne masque plus l’oubli.
+void testBladeEnds()
+{
+    UniformGrid   grid = makeGrid();
+    ProjectileSim sim;
+    const float   size   = 0.2f;
+    const float   radius = 0.5f * size;                       // Rayon indexé (fruit immobile)
+    const float   reach  = radius + kBladeHalfWidth * 0.9f;   // Sous le seuil narrowphase
+
+    // Pointe : bord haut de la boîte sans demi-largeur = 2,99 ; fruit en y > 3
+    const Vec3 swordTip { 0.f, 2.99f - kBladeTip - radius, 6.5f };
+    // Base : bord bas de la boîte sans demi-largeur = 1,01 ; fruit en y < 1
+    const Vec3 swordBase{ 0.f, 1.01f - kBladeBase + radius, 6.5f };
+
+    sim.resize(2);
+    ProjectileSim::Launch l;
+    l.size  = size;
+    l.start = { swordTip.x, swordTip.y + kBladeTip + reach, swordTip.z };
+    sim.launch(0, l);
+    l.start = { swordBase.x, swordBase.y + kBladeBase - reach, swordBase.z };
+    sim.launch(1, l);
+    grid.build(sim);
+
+    int hits = 0;
+    checkBlade(grid, sim, swordTip,  swordTip,  "blade tip", hits);
+    checkBlade(grid, sim, swordBase, swordBase, "blade base", hits);
+    if (hits != 2 && ++s_failures <= kMaxReports)
+        printf("FAIL blade ends: %d of 2 fruits hit by the narrowphase\n", hits);
+}
+
+// Minimum sur une grille (n+1)² de paramètres (s, t) ∈ [0, 1]²
+float sampledDistance(const Vec3& p0, const Vec3& p1, const Vec3& q0, const Vec3& q1, int n)
+{
+    float best = INFINITY;
+    for (int i = 0; i <= n; ++i) {
+        const Vec3 p = lerp(p0, p1, float(i) / n);
+        for (int j = 0; j <= n; ++j)
+            best = min(best, length(sub(p, lerp(q0, q1, float(j) / n))));
+    }
+    return best;
+}
+
+void testSegmentDistance()
+{
+    constexpr int kCases   = 20000;
+    constexpr int kSamples = 64;
+    const Vec3 lo{ -2.f, -2.f, -2.f }, hi{ 2.f, 2.f, 2.f };
+
+    for (int c = 0; c < kCases; ++c) {
+        Vec3 p0 = randomPoint(lo, hi), p1 = randomPoint(lo, hi);
+        Vec3 q0 = randomPoint(lo, hi), q1 = randomPoint(lo, hi);
+        switch (c % 8) {
+        case 0: p1 = p0; break;                                      // Point / segment
+        case 1: q1 = q0; break;                                      // Segment / point
+        case 2: p1 = p0; q1 = q0; break;                             // Point / point
+        case 3: q1 = add(q0, lerp({}, sub(p1, p0), uniform(-1.5f, 1.5f))); break;   // Parallèles
+        case 4: q0 = lerp(p0, p1, uniform(0.f, 1.f)); break;        // Sécants
+        default: break;
+        }
+
+        const float got     = segmentSegmentDistance(p0, p1, q0, q1);
+        const float sampled = sampledDistance(p0, p1, q0, q1, kSamples);
+        // Point exact le plus proche à au plus un demi-pas d’un échantillon sur chaque segment
+        const float slack   = 0.5f * (length(sub(p1, p0)) + length(sub(q1, q0))) / kSamples;
+        const bool  ok      = got <= sampled + 1e-4f && got >= sampled - slack - 1e-4f;
+        if (!ok && ++s_failures <= kMaxReports)
+            printf("FAIL segment distance case %d: got %g, sampled %g (slack %g)\n",
+                   c, got, sampled, slack);
+    }
+    printf("segment distance: %d cases against %dx%d sampling\n", kCases, kSamples + 1, kSamples + 1);
+}
+
+} // namespace
+
+int main()
+{
+    testGridAgainstBruteForce();
+    testBladeEnds();
+    testSegmentDistance();
+
+    if (s_failures > 0) {
+        printf("%d failure(s)\n", s_failures);
+        return 1;
+    }
+    printf("OK: grid matches brute force, segment distance matches sampling\n");
+    return 0;
+}
@@ -0,0 +1,23 @@
+#-------------------------------------------------
+# Test : collisions sabre / projectiles (broadphase.cpp), sans Qt.
+#  → UniformGrid::querySweptSegment comparée à la force brute.
+#  → segmentSegmentDistance comparée à un échantillonnage des deux segments.
+# Code de sortie non nul en cas d’écart : qmake && make && ./test_collision
+#-------------------------------------------------
+
+CONFIG   += c++17 console
+CONFIG   -= app_bundle qt
+
+TEMPLATE = app
+TARGET   = test_collision
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../broadphase.cpp \
+    ../../projectilesim.cpp
+
+HEADERS += \
+    ../../broadphase.h \
+    ../../projectilesim.h
@@ -0,0 +1,196 @@
+// test_skinsegment : noyau peau fusionné (skinsegment.h) comparé à la chaîne OpenCV
+// d’origine, cv::cvtColor(COLOR_BGR2YCrCb) + cv::inRange, octet pour octet.
+//  → Les 2^24 couleurs BGR (image 4096×4096), plusieurs jeux de seuils.
+//  → Chaque ISA supporté par la machine (scalaire, SSSE3, AVX2).
+//  → ROI à largeur impaire, pointeurs non alignés, pas (step) ≠ largeur, largeurs 1..70
+//    (queues scalaires des boucles SIMD) ; aucune écriture hors des ROI de sortie.
+// Code de sortie : 0 si tout est identique, 1 sinon.
+
+#include "skinsegment.h"
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+namespace {
+
+constexpr int     kSide     = 4096;   // 4096 × 4096 = 2^24 couleurs
+constexpr uchar   kSentinel = 0xCD;   // Remplissage autour des ROI de sortie
+constexpr int     kMaxReports = 10;   // Écarts détaillés avant de se taire
+
+int s_failures = 0;
+
+// Pixel (x, y) = couleur y * 4096 + x : B poids faible, R poids fort
+Mat allColours()
+{
+    Mat bgr(kSide, kSide, CV_8UC3);
+    for (int y = 0; y < kSide; ++y) {
+        uchar* row = bgr.ptr<uchar>(y);
+        for (int x = 0; x < kSide; ++x) {
+            const unsigned c = unsigned(y) * kSide + unsigned(x);
+            row[3 * x + 0] = uchar(c);
+            row[3 * x + 1] = uchar(c >> 8);
+            row[3 * x + 2] = uchar(c >> 16);
+        }
+    }
+    return bgr;
+}
+
+void fail(const string& what, int x, int y, int got, int expected)
+{
+    if (++s_failures <= kMaxReports)
+        printf("FAIL %s at (%d, %d): got %d, expected %d\n", what.c_str(), x, y, got, expected);
+}
+
+// Compare deux plans 8 bits de même taille, au premier écart près par ligne
+void expectEqual(const Mat& got, const Mat& expected, const string& what)
+{
+    CV_Assert(got.size() == expected.size() && got.type() == CV_8U && expected.type() == CV_8U);
+    for (int y = 0; y < got.rows; ++y) {
+        const uchar* g = got.ptr<uchar>(y);
+        const uchar* e = expected.ptr<uchar>(y);
+        for (int x = 0; x < got.cols; ++x) {
+            if (g[x] != e[x]) {
+                fail(what, x, y, g[x], e[x]);
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Plan de sortie entouré d’une marge (1 colonne à gauche, pad à droite, une ligne
+ * dessus / dessous) : le pas ne vaut pas la largeur et le début n’est pas aligné.
+ */
+struct PaddedPlane {
+    Mat  storage;
+    Rect roi;
+
+    PaddedPlane(Size size, int pad)
+        : storage(size.height + 2, size.width + 1 + pad, CV_8U, Scalar(kSentinel))
+        , roi(1, 1, size.width, size.height) {}
+
+    Mat view() { return storage(roi); }
+
+    void expectUntouchedMargin(const string& what) const
+    {
+        for (int y = 0; y < storage.rows; ++y) {
+            const uchar* row = storage.ptr<uchar>(y);
+            for (int x = 0; x < storage.cols; ++x) {
+                if (!roi.contains(Point(x, y)) && row[x] != kSentinel) {
+                    fail(what + " (write outside the ROI)", x - roi.x, y - roi.y, row[x], kSentinel);
+                    return;
+                }
+            }
+        }
+    }
+};
+
+string describe(const skin::Thresholds& th)
+{
+    char text[64];
+    snprintf(text, sizeof(text), "cr[%d,%d] cb[%d,%d]", th.crMin, th.crMax, th.cbMin, th.cbMax);
+    return text;
+}
+
+vector<skin::Isa> isasToTest()
+{
+    const int best = int(skin::bestIsa());
+    vector<skin::Isa> isas = { skin::Isa::Scalar };
+    if (best >= int(skin::Isa::Ssse3)) isas.push_back(skin::Isa::Ssse3);
+    if (best >= int(skin::Isa::Avx2))  isas.push_back(skin::Isa::Avx2);
+    return isas;
+}
+
+/*
+ * Vérifie segmentBgr et bgrToCrCb + thresholdCrCb sur bgr (ROI quelconque)
+ * pour chaque ISA et chaque jeu de seuils.
+ */
+void checkRegion(const Mat& bgr, const vector<skin::Thresholds>& thresholds,
+                 const vector<skin::Isa>& isas, const string& label, int pad)
+{
+    // Référence OpenCV, calculée une fois par région
+    Mat ycrcb, refCr, refCb;
+    cvtColor(bgr, ycrcb, COLOR_BGR2YCrCb);
+    extractChannel(ycrcb, refCr, 1);
+    extractChannel(ycrcb, refCb, 2);
+
+    for (skin::Isa isa : isas) {
+        const string base = label + " [" + skin::isaName(isa) + "]";
+
+        PaddedPlane cr(bgr.size(), pad), cb(bgr.size(), pad);
+        Mat crView = cr.view(), cbView = cb.view();
+        skin::bgrToCrCb(bgr.data, bgr.step, crView.data, crView.step,
+                        cbView.data, cbView.step, bgr.cols, bgr.rows, isa);
+        expectEqual(crView, refCr, base + " bgrToCrCb Cr");
+        expectEqual(cbView, refCb, base + " bgrToCrCb Cb");
+        cr.expectUntouchedMargin(base + " bgrToCrCb Cr");
+        cb.expectUntouchedMargin(base + " bgrToCrCb Cb");
+
+        for (const skin::Thresholds& th : thresholds) {
+            const string what = base + " " + describe(th);
+
+            Mat refMask;
+            inRange(ycrcb, Scalar(0, th.crMin, th.cbMin), Scalar(255, th.crMax, th.cbMax), refMask);
+
+            PaddedPlane fused(bgr.size(), pad);
+            Mat fusedView = fused.view();
+            skin::segmentBgr(bgr.data, bgr.step, fusedView.data, fusedView.step,
+                             bgr.cols, bgr.rows, th, isa);
+            expectEqual(fusedView, refMask, what + " segmentBgr");
+            fused.expectUntouchedMargin(what + " segmentBgr");
+
+            PaddedPlane split(bgr.size(), pad);
+            Mat splitView = split.view();
+            skin::thresholdCrCb(crView.data, crView.step, cbView.data, cbView.step,
+                                splitView.data, splitView.step, bgr.cols, bgr.rows, th, isa);
+            expectEqual(splitView, refMask, what + " bgrToCrCb+thresholdCrCb");
+            split.expectUntouchedMargin(what + " thresholdCrCb");
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    const vector<skin::Isa> isas = isasToTest();
+    printf("ISAs tested:");
+    for (skin::Isa isa : isas) printf(" %s", skin::isaName(isa));
+    printf(" (best on this CPU: %s)\n", skin::isaName(skin::bestIsa()));
+
+    // Défaut de PalmDetector, bornes extrêmes, intervalle d’un seul niveau, intervalle vide
+    const vector<skin::Thresholds> thresholds = {
+        skin::Thresholds(),
+        { 0, 255, 0, 255 },
+        { 128, 128, 128, 128 },
+        { 1, 254, 1, 254 },
+        { 200, 100, 140, 70 },
+    };
+
+    const Mat colours = allColours();
+
+    // Toutes les couleurs, image contiguë
+    checkRegion(colours, thresholds, isas, "all colours", 0);
+
+    // Largeur impaire, début non aligné, pas d’entrée ≠ 3 × largeur
+    checkRegion(colours(Rect(3, 5, kSide - 7, kSide - 9)), thresholds, isas, "odd ROI", 5);
+
+    // Petites largeurs : seules les queues scalaires / un bloc SIMD partiel travaillent
+    const vector<skin::Thresholds> defaults = { skin::Thresholds() };
+    for (int width = 1; width <= 70; ++width) {
+        const Rect roi((width * 37) % (kSide - width), (width * 53) % (kSide - 64), width, 64);
+        checkRegion(colours(roi), defaults, isas, "width " + to_string(width), width % 3 + 1);
+    }
+
+    if (s_failures > 0) {
+        printf("%d mismatch(es)\n", s_failures);
+        return 1;
+    }
+    printf("OK: fused skin kernel matches cvtColor + inRange\n");
+    return 0;
+}
@@ -0,0 +1,32 @@
+#-------------------------------------------------
+# Test : noyau peau fusionné (skinsegment.cpp) bit-exact avec
+# cv::cvtColor(BGR2YCrCb) + cv::inRange, pour chaque ISA disponible.
+# Code de sortie non nul en cas d’écart : qmake && make && ./test_skinsegment
+#-------------------------------------------------
+
+CONFIG   += c++17 console
+CONFIG   -= app_bundle qt
+
+TEMPLATE = app
+TARGET   = test_skinsegment
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../skinsegment.cpp
+
+HEADERS += \
+    ../../skinsegment.h
+
+#----- OpenCV : même installation que sdd.pro sous Windows, pkg-config ailleurs -----
+win32 {
+    OPENCV_DIR = C:/opencv/opencv-4.10.0/build/install
+    INCLUDEPATH += $$OPENCV_DIR/include
+    LIBS += -L$$OPENCV_DIR/x64/mingw/lib \
+            -lopencv_core4100 \
+            -lopencv_imgproc4100
+} else {
+    CONFIG    += link_pkgconfig
+    PKGCONFIG += opencv4
+}
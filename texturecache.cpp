@@ -0,0 +1,63 @@
+#include "texturecache.h"
+#include <QFile>
+#include <QImage>
+#include <QDebug>
+
+static QString textureForShape(Projectile::Shape s) {
+    switch (s) {
+    case Projectile::Shape::Apple:   return "C:/Users/khali/dev/sd lakheeer/assets/apple.jpg";
+    case Projectile::Shape::bannana: return "C:/Users/khali/dev/sd lakheeer/assets/banana.jpg";
+    case Projectile::Shape::Cherry:  return "C:/Users/khali/dev/sd lakheeer/assets/cherry.jpg";
+    case Projectile::Shape::IceCube: return "C:/Users/khali/dev/sd lakheeer/assets/ice.jpg";
+    }
+    return "";
+}
+
+TextureCache& TextureCache::instance()
+{
+    static TextureCache cache;
+    return cache;
+}
+
+void TextureCache::initialize()
+{
+    if (m_initialized)
+        return;
+
+    const Projectile::Shape shapes[Projectile::kShapeCount] = {
+        Projectile::Shape::Apple,
+        Projectile::Shape::Cherry,
+        Projectile::Shape::IceCube,
+        Projectile::Shape::bannana
+    };
+    for (Projectile::Shape s : shapes) {
+        QString path = textureForShape(s);
+        if (!QFile::exists(path)) {
+            qWarning() << "Missing projectile texture:" << path;
+            continue;
+        }
+        QImage img(path);
+        img = img.mirrored();
+        QOpenGLTexture* tex = new QOpenGLTexture(img);
+        tex->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
+        tex->setMagnificationFilter(QOpenGLTexture::Linear);
+        tex->setWrapMode(QOpenGLTexture::Repeat);
+        m_layers[layerFor(s)].reset(tex);
+    }
+
+    m_initialized = true;
+}
+
+void TextureCache::destroy()
+{
+    for (auto& tex : m_layers)
+        tex.reset();
+    m_initialized = false;
+}
+
+QOpenGLTexture* TextureCache::texture(int layer) const
+{
+    if (layer < 0 || layer >= Projectile::kShapeCount)
+        return nullptr;
+    return m_layers[layer].data();
+}
@@ -0,0 +1,37 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <QOpenGLTexture>
+#include <QScopedPointer>
+#include <array>
+#include "projectile.h"
+
+/*
+ * Classe TextureCache :
+ * → Cache global des textures de projectiles (pomme, banane, cerise, glace).
+ * → Chargées une seule fois au démarrage (GameScene::initializeGL) : les respawns
+ *   ne font plus ni I/O disque, ni décodage JPEG, ni génération de mipmaps.
+ * → Chaque forme occupe une couche (layer) sélectionnée par index.
+ */
+class TextureCache
+{
+public:
+    static TextureCache& instance();          // Cache unique du process
+
+    void initialize();                        // Charge les textures (contexte GL courant)
+    void destroy();                           // Libère les textures (contexte GL courant)
+    bool isInitialized() const { return m_initialized; }
+
+    static int layerFor(Projectile::Shape s) { return static_cast<int>(s); }
+    QOpenGLTexture* texture(int layer) const; // nullptr si couche absente
+
+private:
+    TextureCache() = default;
+    TextureCache(const TextureCache&)            = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    std::array<QScopedPointer<QOpenGLTexture>, Projectile::kShapeCount> m_layers;
+    bool m_initialized = false;
+};
+
+#endif // TEXTURECACHE_H
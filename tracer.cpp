@@ -0,0 +1,104 @@
+#include "tracer.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+
+namespace {
+
+struct Event {
+    const char*       name;
+    Clock::time_point begin;
+    Clock::time_point end;
+};
+
+// Au-delà, les événements sont comptés mais pas retenus (~24 Mo par thread)
+constexpr std::size_t kMaxEventsPerThread = 1 << 20;
+
+struct ThreadBuffer {
+    int                tid  = 0;
+    const char*        name = nullptr;
+    std::vector<Event> events;
+    std::size_t        dropped = 0;
+};
+
+std::mutex                                 s_mutex;     // Registre des tampons uniquement
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+Clock::time_point                          s_origin;
+
+ThreadBuffer& localBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = s_buffers.back().get();
+        buffer->tid = int(s_buffers.size());
+        buffer->events.reserve(1 << 14);
+    }
+    return *buffer;
+}
+
+double micros(Clock::time_point t)
+{
+    return std::chrono::duration<double, std::micro>(t - s_origin).count();
+}
+
+} // namespace
+
+void start()
+{
+    s_origin = Clock::now();
+    enabledFlag().store(true, std::memory_order_release);
+}
+
+void setThreadName(const char* name)
+{
+    if (enabled())
+        localBuffer().name = name;
+}
+
+void complete(const char* name, Clock::time_point begin, Clock::time_point end)
+{
+    ThreadBuffer& buffer = localBuffer();
+    if (buffer.events.size() < kMaxEventsPerThread)
+        buffer.events.push_back({ name, begin, end });
+    else
+        ++buffer.dropped;
+}
+
+std::size_t write(std::ostream& out)
+{
+    enabledFlag().store(false, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    std::size_t written = 0;
+    const char* sep = "\n";
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    out.precision(3);
+    out << std::fixed;
+    for (const auto& buffer : s_buffers) {
+        if (buffer->name) {
+            out << sep << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->tid
+                << ", \"args\": {\"name\": \"" << buffer->name << "\"}}";
+            sep = ",\n";
+        }
+        for (const Event& e : buffer->events) {
+            out << sep << "{\"name\": \"" << e.name << "\", \"cat\": \"sdd\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                << buffer->tid << ", \"ts\": " << micros(e.begin)
+                << ", \"dur\": " << std::chrono::duration<double, std::micro>(e.end - e.begin).count() << "}";
+            sep = ",\n";
+            ++written;
+        }
+        if (buffer->dropped) {
+            out << sep << "{\"name\": \"dropped_events\", \"ph\": \"C\", \"pid\": 1, \"tid\": " << buffer->tid
+                << ", \"ts\": 0, \"args\": {\"count\": " << buffer->dropped << "}}";
+            sep = ",\n";
+        }
+    }
+    out << "\n]}\n";
+    return written;
+}
+
+} // namespace trace
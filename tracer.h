@@ -0,0 +1,45 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+/*
+ * Traceur d’événements au format Chrome (chrome://tracing, ui.perfetto.dev) :
+ * → Activé seulement par start() (option --trace) ; sinon complete() n’est jamais atteint
+ *   (les perf::ScopedTimer testent enabled() avant toute lecture d’horloge).
+ * → Un tampon par thread : verrou pris une seule fois, au premier événement du thread.
+ *   Les tampons appartiennent au traceur et survivent à leurs threads.
+ * → write() ne doit être appelé qu’une fois les threads instrumentés arrêtés.
+ */
+namespace trace {
+
+using Clock = std::chrono::steady_clock;
+
+inline std::atomic<bool>& enabledFlag()
+{
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+inline bool enabled() { return enabledFlag().load(std::memory_order_relaxed); }
+
+void start();                             // Origine des temps = maintenant
+void setThreadName(const char* name);     // Nom affiché pour le thread appelant (chaîne statique)
+
+/**
+ * Événement complet (ph "X" = début + durée) sur le thread appelant.
+ * @param name chaîne statique (ex. perf::probeName)
+ */
+void complete(const char* name, Clock::time_point begin, Clock::time_point end);
+
+/**
+ * Arrête l’enregistrement et écrit {"traceEvents": [...]}.
+ * @return nombre d’événements écrits
+ */
+std::size_t write(std::ostream& out);
+
+} // namespace trace
+
+#endif // TRACER_H